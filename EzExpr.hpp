@@ -29,17 +29,28 @@ SOFTWARE.
 #endif // _USE_MATH_DEFINES
 
 #include <array>
+#include <algorithm>
+#include <cstdint>
 #include <math.h>
 #include <string>
 #include <vector>
+#include <list>
 #include <limits>
 #include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <exception>
+#include <condition_variable>
 #include <chrono>
 #include <cstring>
+#include <cstdlib>
 #include <sstream>
 #include <iostream>
 #include <functional>
+#include <initializer_list>
 #include <unordered_map>
+#include <stdexcept>
 
 #ifndef DONT_DEFINE_DEFAULT_BUILTINS
 #define DEFINE_DEFAULT_BUILTINS
@@ -49,13 +60,116 @@ SOFTWARE.
 #define USE_PERFO_MEASURING
 #endif  // DONT_USE_PERFO_MEASURING
 
+#ifndef DONT_USE_EXCEPTIONS
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define USE_EXCEPTIONS
+#endif
+#endif  // DONT_USE_EXCEPTIONS
+
+#ifndef DONT_USE_SIMD_KERNELS
+#if defined(__x86_64__) || defined(_M_X64)
+#define USE_SIMD_KERNELS
+#endif
+#endif  // DONT_USE_SIMD_KERNELS
+
+#ifndef DONT_USE_JIT
+#if defined(__linux__) && defined(__x86_64__)
+#define USE_JIT
+#endif
+#endif  // DONT_USE_JIT
+
+#ifndef DONT_USE_CONSTEXPR_PARSING
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#define USE_CONSTEXPR_PARSING
+#endif
+#endif  // DONT_USE_CONSTEXPR_PARSING
+
+#ifdef USE_JIT
+#include <sys/mman.h>
+#endif  // USE_JIT
+
+#ifdef USE_SIMD_KERNELS
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define EZ_TARGET_AVX2
+#else
+#define EZ_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif  // USE_SIMD_KERNELS
+
 namespace ez {
 
 // Class that encapsulates a string
+// the strings shorter than s_LocalSize are stored in the object, the names of the expressions being most of the time short
 class String {
 private:
-    char* m_Data;     // Pointer to the character string
-    size_t m_Length;  // Length of the string
+    static constexpr size_t s_LocalSize = 16U;  // Storage in the object, the ending zero included
+
+    char* m_Data;                // Pointer to the character string, m_Local for a short string
+    size_t m_Length;             // Length of the string
+    size_t m_Hash = 0;           // Hash of the characters, computed once by the constructors and copied with them
+    char m_Local[s_LocalSize];   // Storage of a short string
+
+    // Returns the hash of characters, read by words of 8 bytes and mixed like splitmix64
+    // 0 for an empty string, like the default constructed and the moved-from strings
+    static size_t m_computeHash(const char* vData, const size_t vLength) {
+        if (vLength == 0U) {
+            return 0U;
+        }
+        uint64_t hash = 0x9E3779B97F4A7C15ULL ^ vLength;
+        size_t idx    = 0;
+        for (; idx + 8U <= vLength; idx += 8U) {
+            uint64_t word;
+            ::std::memcpy(&word, vData + idx, 8U);
+            hash = (hash ^ word) * 0xBF58476D1CE4E5B9ULL;
+            hash ^= hash >> 29U;
+        }
+        if (idx < vLength) {
+            uint64_t word = 0U;
+            ::std::memcpy(&word, vData + idx, vLength - idx);
+            hash = (hash ^ word) * 0xBF58476D1CE4E5B9ULL;
+            hash ^= hash >> 29U;
+        }
+        hash = (hash ^ (hash >> 32U)) * 0x94D049BB133111EBULL;
+        return static_cast<size_t>(hash ^ (hash >> 29U));
+    }
+
+    // Point m_Data to a storage of vLength characters and the ending zero
+    void m_allocate(const size_t vLength) {
+        m_Length = vLength;
+        m_Data   = (vLength < s_LocalSize) ? m_Local : new char[vLength + 1];
+    }
+
+    // Releases the storage, if allocated
+    void m_release() {
+        if (m_Data != m_Local) {
+            delete[] m_Data;
+        }
+    }
+
+    // Copy the vLength first characters of vData, nullptr giving an empty string without storage
+    void m_assign(const char* vData, const size_t vLength) {
+        if (vData) {
+            m_allocate(vLength);
+            ::std::memcpy(m_Data, vData, vLength);
+            m_Data[m_Length] = '\0';
+        } else {
+            m_Data   = nullptr;
+            m_Length = 0;
+        }
+    }
+
+    // Returns the concatenation of two strings
+    static String m_concat(const char* vLhs, const size_t vLhsLength, const char* vRhs, const size_t vRhsLength) {
+        String result;
+        result.m_allocate(vLhsLength + vRhsLength);
+        ::std::memcpy(result.m_Data, vLhs, vLhsLength);
+        ::std::memcpy(result.m_Data + vLhsLength, vRhs, vRhsLength);
+        result.m_Data[result.m_Length] = '\0';
+        result.m_Hash                  = m_computeHash(result.m_Data, result.m_Length);
+        return result;
+    }
 
 public:
     // Default constructor: initializes members to nullptr and length to 0
@@ -65,71 +179,55 @@ public:
 
     // Constructor from a std::string
     String(const ::std::string& str) {
-        if (!str.empty()) {
-            m_Length = str.size();
-            m_Data   = new char[m_Length + 1];
-            ::std::memcpy(m_Data, str.data(), m_Length + 1);
-        } else {
-            m_Data   = nullptr;
-            m_Length = 0;
-        }
+        m_assign(str.empty() ? nullptr : str.data(), str.size());
+        m_Hash = m_computeHash(m_Data, m_Length);
     }
 
     // Constructor from a C-style string (const char*)
     String(const char* str) {
-        if (str) {
-            m_Length = ::std::strlen(str);
-            m_Data   = new char[m_Length + 1];
-            ::std::memcpy(m_Data, str, m_Length + 1);
-        } else {
-            m_Data   = nullptr;
-            m_Length = 0;
-        }
+        m_assign(str, str ? ::std::strlen(str) : 0U);
+        m_Hash = m_computeHash(m_Data, m_Length);
+    }
+
+    // Constructor from the vLength first characters of a C-style string
+    String(const char* str, const size_t vLength) {
+        m_assign(str, vLength);
+        m_Hash = m_computeHash(m_Data, m_Length);
     }
 
     // Constructor from a single character
     String(char ch) {
-        m_Length  = 1;
-        m_Data    = new char[2];
-        m_Data[0] = ch;
-        m_Data[1] = '\0';
+        m_assign(&ch, 1U);
+        m_Hash = m_computeHash(m_Data, m_Length);
     }
 
     // Copy constructor
-    String(const String& other) {
-        if (other.m_Data) {
-            m_Length = other.m_Length;
-            m_Data   = new char[m_Length + 1];
-            ::std::memcpy(m_Data, other.m_Data, m_Length + 1);
-        } else {
-            m_Data   = nullptr;
-            m_Length = 0;
-        }
+    String(const String& other) : m_Hash(other.m_Hash) {
+        m_assign(other.m_Data, other.m_Length);
     }
 
-    // Move constructor
-    String(String&& other) noexcept : m_Data(other.m_Data), m_Length(other.m_Length) {
+    // Move constructor, a short string being copied
+    String(String&& other) noexcept : m_Data(other.m_Data), m_Length(other.m_Length), m_Hash(other.m_Hash) {
+        if (other.m_Data == other.m_Local) {
+            m_Data = m_Local;
+            ::std::memcpy(m_Local, other.m_Local, m_Length + 1);
+        }
         other.m_Data   = nullptr;
         other.m_Length = 0;
+        other.m_Hash   = 0;
     }
 
     // Copy assignment operator
-    char operator[](const size_t idx) {
+    char operator[](const size_t idx) const {
         return m_Data[idx];  // no verification
     }
 
     // Copy assignment operator
     String& operator=(const String& other) {
         if (this != &other) {  // Avoid self-assignment
-            delete[] m_Data;   // Free existing memory
-            if (other.m_Data) {
-                m_Length = other.m_Length;
-                m_Data   = new char[m_Length + 1];
-                ::std::memcpy(m_Data, other.m_Data, m_Length + 1);
-            } else {
-                m_Data   = nullptr;
-                m_Length = 0;
-            }
+            m_release();       // Free existing memory
+            m_assign(other.m_Data, other.m_Length);
+            m_Hash = other.m_Hash;
         }
         return *this;
     }
@@ -137,18 +235,24 @@ public:
     // Move assignment operator
     String& operator=(String&& other) noexcept {
         if (this != &other) {  // Avoid self-assignment
-            delete[] m_Data;   // Free existing memory
-            m_Data         = other.m_Data;
-            m_Length       = other.m_Length;
+            m_release();       // Free existing memory
+            if (other.m_Data == other.m_Local) {
+                m_assign(other.m_Data, other.m_Length);  // Short string, copied
+            } else {
+                m_Data   = other.m_Data;
+                m_Length = other.m_Length;
+            }
+            m_Hash         = other.m_Hash;
             other.m_Data   = nullptr;  // Reset moved object
             other.m_Length = 0;
+            other.m_Hash   = 0;
         }
         return *this;
     }
 
     // Destructor: releases allocated memory
     ~String() {
-        delete[] m_Data;
+        m_release();
     }
 
     // Static method to create a String from a double
@@ -168,8 +272,8 @@ public:
 
     // Equality operator
     bool operator==(const String& other) const {
-        if (m_Length != other.m_Length) {
-            return false;  // If lengths are different, strings are different
+        if (m_Length != other.m_Length || m_Hash != other.m_Hash) {
+            return false;  // If lengths or hashes are different, strings are different
         }
         return ::std::memcmp(m_Data, other.m_Data, m_Length) == 0;  // Compare data
     }
@@ -199,23 +303,24 @@ public:
         return m_Length;
     }
 
+    // Returns the hash of the string, computed at its construction
+    size_t getHash() const {
+        return m_Hash;
+    }
+
     // Concatenation operator with another String
     String operator+(const String& other) const {
-        size_t newLength = m_Length + other.m_Length;                         // Calculate new length
-        char* newData    = new char[newLength + 1];                           // Allocate memory
-        ::std::memcpy(newData, m_Data, m_Length);                             // Copy first string
-        ::std::memcpy(newData + m_Length, other.m_Data, other.m_Length + 1);  // Copy second string
-        return String(newData);                                               // Return new String
+        return m_concat(c_str(), m_Length, other.c_str(), other.m_Length);
     }
 
     // Concatenation operator with a C-style string
     String operator+(const char* str) const {
-        size_t strLength = ::std::strlen(str);                  // Calculate length of str
-        size_t newLength = m_Length + strLength;                // Calculate new length
-        char* newData    = new char[newLength + 1];             // Allocate memory
-        ::std::memcpy(newData, m_Data, m_Length);               // Copy first string
-        ::std::memcpy(newData + m_Length, str, strLength + 1);  // Copy str
-        return String(newData);                                 // Return new String
+        return m_concat(c_str(), m_Length, str, ::std::strlen(str));
+    }
+
+    // Overload of the + operator to allow concatenation of const char* and ez::String
+    friend String operator+(const char* lhs, const String& rhs) {
+        return m_concat(lhs, ::std::strlen(lhs), rhs.c_str(), rhs.m_Length);
     }
 
     // Stream output operator overload for displaying the string
@@ -233,12 +338,7 @@ namespace std {
 template <>
 struct hash<ez::String> {
     size_t operator()(const ez::String& s) const noexcept {
-        size_t hash      = 0;
-        const char* data = s.c_str();
-        for (size_t i = 0; i < s.length(); ++i) {
-            hash = hash * 31 + static_cast<size_t>(data[i]);  // Simple hash calculation
-        }
-        return hash;
+        return s.getHash();  // computed once by the String
     }
 };
 
@@ -246,695 +346,5470 @@ struct hash<ez::String> {
 
 namespace ez {
 
-// Overload of the + operator to allow concatenation of const char* and ez::String
-static inline String operator+(const char* lhs, const String& rhs) {
-    size_t lhsLength = ::std::strlen(lhs);                              // Calculate length of lhs
-    size_t newLength = lhsLength + rhs.length();                        // Calculate new length
-    char* newData    = new char[newLength + 1];                         // Allocate memory
-    ::std::memcpy(newData, lhs, lhsLength);                             // Copy lhs
-    ::std::memcpy(newData + lhsLength, rhs.c_str(), rhs.length() + 1);  // Copy rhs
-    return String(newData);                                             // Return new String
-}
+// Map of a String to a value, by open addressing with linear probing
+// the entries are contiguous, in their order of insertion, and the buckets are 64 bits words holding the index of the entry
+// and the high bits of the hash of its key, so a lookup reads most of the time one bucket and one entry
+// the entries are moved when the map grows or when an entry is erased, like the elements of a vector
+// it has the members of std::unordered_map used on the containers of the expressions, the buckets interface excepted
+template <typename TValue>
+class FlatMap {
+public:
+    typedef String key_type;
+    typedef TValue mapped_type;
+    typedef ::std::pair<String, TValue> value_type;
+    typedef typename ::std::vector<value_type>::iterator iterator;
+    typedef typename ::std::vector<value_type>::const_iterator const_iterator;
 
-// Definition of aliases for functions with different numbers of arguments
-typedef ::std::function<double(double)> UnaryFunctor;
-typedef ::std::function<double(double, double)> BinaryFunctor;
-typedef ::std::function<double(double, double, double)> TernaryFunctor;
-typedef ::std::unordered_map<String, double> VarContainer;
-typedef ::std::unordered_map<String, double> ConstantContainer;
+private:
+    static constexpr uint64_t s_IndexMask = 0xFFFFFFFFULL;  // Bits of the index of the entry + 1 in a bucket, 0 for an empty bucket
 
-// Structure representing a function with its number of arguments and behavior
-struct Function {
-    UnaryFunctor unaryFunctor     = nullptr;
-    BinaryFunctor binaryFunctor   = nullptr;
-    TernaryFunctor ternaryFunctor = nullptr;
-    size_t argCount               = 0U;
-};
+    ::std::vector<value_type> m_Entries;  // Entries in their order of insertion
+    ::std::vector<uint64_t> m_Buckets;    // Count being a power of two, at least twice the count of entries
 
-// Container to store available functions
-typedef ::std::unordered_map<String, Function> FunctionContainer;
+    // Returns the high bits of the hash stored in a bucket
+    static uint64_t m_getTag(const String& vKey) {
+        return static_cast<uint64_t>(vKey.getHash()) >> 32U << 32U;
+    }
 
-// Definition of possible token types
-enum class TokenType {
-    NUMBER = 0,
-    LPAREN,
-    RPAREN,
-    VARIABLE,
-    OPERATOR,
-    FUNCTION,
-    SEPARATOR,
-    Count
-};
+    // Returns the bucket of an entry, m_Buckets.size() if not found
+    size_t m_findBucket(const String& vKey) const {
+        if (m_Entries.empty()) {
+            return m_Buckets.size();
+        }
+        const size_t mask  = m_Buckets.size() - 1U;
+        const uint64_t tag = m_getTag(vKey);
+        for (size_t pos = vKey.getHash() & mask;; pos = (pos + 1U) & mask) {
+            const uint64_t bucket = m_Buckets[pos];
+            if (bucket == 0U) {
+                return m_Buckets.size();
+            }
+            if ((bucket & ~s_IndexMask) == tag && m_Entries[(bucket & s_IndexMask) - 1U].first == vKey) {
+                return pos;
+            }
+        }
+    }
 
-// Structure representing a token (lexical unit)
-struct Token {
-    TokenType type;
-    String value;
-};
+    // Store the index of an entry in the first empty bucket of its key
+    void m_insertBucket(const size_t vIndex) {
+        const String& key = m_Entries[vIndex].first;
+        const size_t mask = m_Buckets.size() - 1U;
+        size_t pos        = key.getHash() & mask;
+        while (m_Buckets[pos] != 0U) {
+            pos = (pos + 1U) & mask;
+        }
+        m_Buckets[pos] = m_getTag(key) | (vIndex + 1U);
+    }
 
-// Definition of possible error codes
-enum class ErrorCode {
-    NONE = 0,
-    PARSE_ERROR,
-    EVALUATION_NAN,
-    EVALUATION_INF,
-    DIVISION_BY_ZERO,
-    UNKNOWN_NODE_TYPE,
-    EMPTY_PARENTHESIS,
-    VARIABLE_NOT_FOUND,
-    FUNCTION_NOT_FOUND,
-    OPERATOR_NOT_FOUND,
-    UNMATCHED_PARENTHESIS,
-    FUNCTION_WRONG_ARGUMENTS_COUNT,
-    Count
-};
+    // Rebuild the buckets for vCount entries
+    void m_rehash(const size_t vCount) {
+        size_t bucketsCount = 16U;
+        while (bucketsCount < vCount * 2U) {
+            bucketsCount *= 2U;
+        }
+        if (bucketsCount <= m_Buckets.size()) {
+            return;
+        }
+        m_Buckets.assign(bucketsCount, 0U);
+        for (size_t idx = 0; idx < m_Entries.size(); ++idx) {
+            m_insertBucket(idx);
+        }
+    }
 
-// Definition of possible node types in a syntax tree
-enum class NodeType {
-    NUMBER = 0,
-    VARIABLE,
-    OPERATOR,
-    FUNCTION,
-    Count
-};
+public:
+    FlatMap() = default;
 
-// Structure representing a node in the syntax tree
-struct Node {
-    NodeType type = NodeType::NUMBER;
-    String name;
-    double value = 0.0;
-    ::std::array< ::std::shared_ptr<Node>, 3> childs{};  // Array of pointers to child nodes
-    ::std::array<double, 3> tmp{};                       // for avoid allocation during evaluation
-    size_t childCount = 0;
-};
+    FlatMap(::std::initializer_list<value_type> vEntries) {
+        reserve(vEntries.size());
+        insert(vEntries.begin(), vEntries.end());
+    }
 
-// Class to manage exceptions specific to expression evaluation
-class ExprException : public ::std::exception {
-public:
-    ExprException(ErrorCode code, const String& message)
-        : m_Code(code), m_Message(message) {
+    iterator begin() {
+        return m_Entries.begin();
+    }
+    iterator end() {
+        return m_Entries.end();
+    }
+    const_iterator begin() const {
+        return m_Entries.begin();
+    }
+    const_iterator end() const {
+        return m_Entries.end();
+    }
+    const_iterator cbegin() const {
+        return m_Entries.cbegin();
+    }
+    const_iterator cend() const {
+        return m_Entries.cend();
+    }
+    size_t size() const {
+        return m_Entries.size();
+    }
+    bool empty() const {
+        return m_Entries.empty();
     }
 
-    ErrorCode getCode() const {
-        return m_Code;
+    // Remove the entries, the buckets are kept
+    void clear() {
+        m_Entries.clear();
+        ::std::fill(m_Buckets.begin(), m_Buckets.end(), 0U);
     }
 
-    const char* what() const noexcept override {
-        return m_Message.c_str();  // Return the error message
+    // Prepare the map for vCount entries
+    void reserve(const size_t vCount) {
+        m_Entries.reserve(vCount);
+        m_rehash(vCount);
     }
 
-private:
-    ErrorCode m_Code;
-    String m_Message;
-};
+    iterator find(const String& vKey) {
+        const size_t pos = m_findBucket(vKey);
+        return (pos == m_Buckets.size()) ? end() : begin() + static_cast<ptrdiff_t>((m_Buckets[pos] & s_IndexMask) - 1U);
+    }
 
-// Main class for evaluating mathematical expressions
-class Expr {
-private:
-    String m_Expr;                                            // Expression to evaluate
-    Node m_RootExpr;                                          // Root of the syntax tree
-    VarContainer m_ParsedVariables;                           // Container for variables found during parsing
-    VarContainer m_DefinedVariables;                          // Container for variables defined after parsing
-    ConstantContainer m_Constant;                             // Container for constants
-    FunctionContainer m_Functions;                            // Container for functions
-    double m_EvalResult = 0.0;                                // Evaluation result
-    bool m_Verbose      = false;                              // Verbose mode
-    ::std::stringstream m_printExpr;                          // Stream to print the expression and result
-    ::std::chrono::duration<double, ::std::milli> m_Elapsed;  // Evaluation time
-    ::std::chrono::steady_clock::time_point m_StartTime;
-    ::std::chrono::steady_clock::time_point m_EndTime;
+    const_iterator find(const String& vKey) const {
+        const size_t pos = m_findBucket(vKey);
+        return (pos == m_Buckets.size()) ? end() : begin() + static_cast<ptrdiff_t>((m_Buckets[pos] & s_IndexMask) - 1U);
+    }
 
-public:
-    Expr() {
-#ifdef DEFINE_DEFAULT_BUILTINS
-        defineDefaultBuiltins();
-#endif  // DEFINE_DEFAULT_BUILTINS
+    size_t count(const String& vKey) const {
+        return (m_findBucket(vKey) == m_Buckets.size()) ? 0U : 1U;
     }
 
-    void defineDefaultBuiltins() {
-        // Initialization of common constants
-        addConstant("pi", M_PI);  // PI
-        addConstant("e", M_E);    // e
+    // Insert an entry if its key is not found, returns the entry of the key and true if inserted
+    ::std::pair<iterator, bool> emplace(const String& vKey, TValue vValue) {
+        auto it = find(vKey);
+        if (it != end()) {
+            return ::std::make_pair(it, false);
+        }
+        m_rehash(m_Entries.size() + 1U);
+        m_Entries.emplace_back(vKey, ::std::move(vValue));
+        m_insertBucket(m_Entries.size() - 1U);
+        return ::std::make_pair(end() - 1, true);
+    }
+
+    // Insert an entry if its key is not found, returns the entry of the key and true if inserted
+    ::std::pair<iterator, bool> insert(const value_type& vEntry) {
+        return emplace(vEntry.first, vEntry.second);
+    }
+
+    // Insert the entries whose key is not found
+    template <typename TIterator>
+    void insert(TIterator vFirst, const TIterator vLast) {
+        for (; vFirst != vLast; ++vFirst) {
+            emplace(vFirst->first, vFirst->second);
+        }
+    }
 
-        // Initialization of common unary functions
-        addFunction("-", [](double a) { return -a; });
+    // Returns the value of a key, inserted with the default value if not found
+    TValue& operator[](const String& vKey) {
+        return emplace(vKey, TValue()).first->second;
+    }
 
-        addFunction("abs", [](double a) { return ::std::abs(a); });
-        addFunction("floor", [](double a) { return ::std::floor(a); });
-        addFunction("ceil", [](double a) { return ::std::ceil(a); });
-        addFunction("round", [](double a) { return ::std::round(a); });
+    // Returns the value of a key, throws std::out_of_range if not found
+    // if the exceptions are disabled, the program is aborted
+    TValue& at(const String& vKey) {
+        auto it = find(vKey);
+        if (it == end()) {
+#ifdef USE_EXCEPTIONS
+            throw ::std::out_of_range("FlatMap::at : key not found");
+#else
+            ::std::abort();
+#endif  // USE_EXCEPTIONS
+        }
+        return it->second;
+    }
 
-        addFunction("fract", [](double a) { return a - ::std::floor(a); });
-        addFunction("sign", [this](double a) { return m_Sign(a); });
+    const TValue& at(const String& vKey) const {
+        return const_cast<FlatMap*>(this)->at(vKey);
+    }
 
-        addFunction("sin", [](double a) { return ::std::sin(a); });
-        addFunction("cos", [](double a) { return ::std::cos(a); });
-        addFunction("tan", [](double a) { return ::std::tan(a); });
+    // Remove the entry of a key, returns the count of removed entries
+    // the last entry takes the place of the removed one
+    size_t erase(const String& vKey) {
+        size_t pos = m_findBucket(vKey);
+        if (pos == m_Buckets.size()) {
+            return 0U;
+        }
+        const size_t mask  = m_Buckets.size() - 1U;
+        const size_t index = (m_Buckets[pos] & s_IndexMask) - 1U;
+        // backward shift of the next buckets of the probe sequence, so no bucket is marked as removed
+        m_Buckets[pos] = 0U;
+        for (size_t next = (pos + 1U) & mask; m_Buckets[next] != 0U; next = (next + 1U) & mask) {
+            const size_t home = m_Entries[(m_Buckets[next] & s_IndexMask) - 1U].first.getHash() & mask;
+            if (((pos - home) & mask) < ((next - home) & mask)) {
+                m_Buckets[pos]  = m_Buckets[next];
+                m_Buckets[next] = 0U;
+                pos             = next;
+            }
+        }
+        const size_t last = m_Entries.size() - 1U;
+        if (index != last) {
+            const String& key = m_Entries[last].first;
+            size_t lastPos    = key.getHash() & mask;
+            while ((m_Buckets[lastPos] & s_IndexMask) != last + 1U) {
+                lastPos = (lastPos + 1U) & mask;
+            }
+            m_Buckets[lastPos]  = m_getTag(key) | (index + 1U);
+            m_Entries[index]    = ::std::move(m_Entries[last]);
+        }
+        m_Entries.pop_back();
+        return 1U;
+    }
 
-        addFunction("asin", [](double a) { return ::std::asin(a); });
-        addFunction("acos", [](double a) { return ::std::acos(a); });
-        addFunction("atan", [](double a) { return ::std::atan(a); });
+    // Remove an entry, returns the iterator at its place, holding the last entry or end() if it was the last one
+    // so a loop erasing some entries visits all of them
+    iterator erase(const_iterator vPos) {
+        const ptrdiff_t index = vPos - cbegin();
+        erase(m_Entries[static_cast<size_t>(index)].first);
+        return begin() + index;
+    }
+};
 
-        addFunction("sinh", [](double a) { return ::std::sinh(a); });
-        addFunction("cosh", [](double a) { return ::std::cosh(a); });
-        addFunction("tanh", [](double a) { return ::std::tanh(a); });
+// Definition of aliases for functions with different numbers of arguments
+typedef ::std::function<double(double)> UnaryFunctor;
+typedef ::std::function<double(double, double)> BinaryFunctor;
+typedef ::std::function<double(double, double, double)> TernaryFunctor;
+// unlike std::unordered_map, an insertion or an erasure invalidates the references and iterators to the entries
+typedef FlatMap<double> VarContainer;
+typedef FlatMap<double> ConstantContainer;
 
-        addFunction("asinh", [](double a) { return ::std::asinh(a); });
-        addFunction("acosh", [](double a) { return ::std::acosh(a); });
-        addFunction("atanh", [](double a) { return ::std::atanh(a); });
+// Definition of the instruction sets usable by the batch evaluation
+enum class InstructionSet {
+    SCALAR = 0,  // portable code
+    SSE2,        // x86-64 baseline, 2 values at a time
+    AVX2,        // 4 values at a time
+    Count
+};
 
-        addFunction("ln", [](double a) { return ::std::log(a); });
-        addFunction("log", [](double a) { return ::std::log(a); });
-        addFunction("log1p", [](double a) { return ::std::log1p(a); });
-        addFunction("logb", [](double a) { return ::std::logb(a); });
-        addFunction("log2", [](double a) { return ::std::log2(a); });
-        addFunction("log10", [](double a) { return ::std::log10(a); });
+// Kernels applied to blocks of values by the batch evaluation, the result is written in the first block
+// the operators and the glsl builtins are bit identical to the scalar evaluation, the maths functions of SSE2 and AVX2
+// are within the ulp given by EZ_SIMD_MATH_FUNCTIONS, so only InstructionSet::SCALAR matches eval() bit for bit
+namespace simd {
 
-        addFunction("sqrt", [](double a) { return ::std::sqrt(a); });
-        addFunction("exp", [](double a) { return ::std::exp(a); });
+typedef void (*UnaryKernel)(double* vA, size_t vCount);
+typedef void (*BinaryKernel)(double* vA, const double* vB, size_t vCount);
+typedef void (*TernaryKernel)(double* vA, const double* vB, const double* vC, size_t vCount);
+typedef bool (*CheckKernel)(const double* vA, size_t vCount);
 
-        addFunction("fact", [this](double a) { return m_Factorial(a); });
+// Set of kernels for an instruction set
+struct Kernels {
+    InstructionSet instructionSet = InstructionSet::SCALAR;
+    BinaryKernel add              = nullptr;
+    BinaryKernel sub              = nullptr;
+    BinaryKernel mul              = nullptr;
+    BinaryKernel div              = nullptr;
+    BinaryKernel min              = nullptr;
+    BinaryKernel max              = nullptr;
+    BinaryKernel step             = nullptr;
+    UnaryKernel neg               = nullptr;
+    UnaryKernel abs               = nullptr;
+    UnaryKernel sqrt              = nullptr;
+    UnaryKernel sign              = nullptr;
+    UnaryKernel fract             = nullptr;
+    UnaryKernel saturate          = nullptr;
+    TernaryKernel clamp           = nullptr;
+    TernaryKernel mix             = nullptr;
+    TernaryKernel smoothstep      = nullptr;
+    UnaryKernel exp               = nullptr;  // the math functions are nullptr for the standard library ones
+    UnaryKernel log               = nullptr;
+    UnaryKernel log2              = nullptr;
+    UnaryKernel log10             = nullptr;
+    UnaryKernel sin               = nullptr;
+    UnaryKernel cos               = nullptr;
+    UnaryKernel tan               = nullptr;
+    BinaryKernel atan2            = nullptr;
+    BinaryKernel pow              = nullptr;
+    CheckKernel hasZero           = nullptr;  // true if a value is 0 or -0
+    CheckKernel hasNanOrInf       = nullptr;  // true if a value is NaN or Inf
+};
 
-        addFunction("saturate", [this](double a) { return m_Clamp(a, 0.0, 1.0); });
+// Math functions on the vectors of an instruction set, defined with the primitives of the instruction set
+// the algorithms are the same for all the instruction sets, so the vector lanes and the scalar code give the same results
+// max errors measured against the standard library (ulp): exp 1, log 1, log2 1, log10 2, sin 1, cos 1, tan 2, atan2 2, pow 1
+#define EZ_SIMD_MATH_FUNCTIONS(TARGET)                                                                                 \
+TARGET inline vec vselect(const vec vMask, const vec vA, const vec vB) {                                               \
+    return vor(vand(vMask, vA), vandnot(vMask, vB));                                                                   \
+}                                                                                                                      \
+TARGET inline vec vabs(const vec vA) {                                                                                 \
+    return vandnot(vset(-0.0), vA);                                                                                    \
+}                                                                                                                      \
+TARGET inline vec vcopysign(const vec vA, const vec vSign) {                                                           \
+    return vor(vandnot(vset(-0.0), vA), vand(vset(-0.0), vSign));                                                      \
+}                                                                                                                      \
+/* mask of the NaNs and the infinites */                                                                                   \
+TARGET inline vec vnotfinite(const vec vA) {                                                                           \
+    return vandnot(vlt(vabs(vA), vset(::std::numeric_limits<double>::infinity())), vsetbits(~0ULL));                   \
+}                                                                                                                      \
+TARGET inline vec vnotfinite(const vec vA, const vec vB) {                                                             \
+    return vor(vnotfinite(vA), vnotfinite(vB));                                                                        \
+}                                                                                                                      \
+/* round to the nearest integer, for |vA| < 2^51 */                                                                    \
+TARGET inline vec vround(const vec vA) {                                                                               \
+    return vsub(vadd(vA, vset(6755399441055744.0)), vset(6755399441055744.0));                                         \
+}                                                                                                                      \
+/* 2^vN for an integer vN in [-1022, 1023] */                                                                          \
+TARGET inline vec vpow2i(const vec vN) {                                                                               \
+    return vshl52(vadd(vN, vset(4503599627370496.0 + 1023.0)));                                                        \
+}                                                                                                                      \
+/* biased exponent of a positive value */                                                                              \
+TARGET inline vec vexponent(const vec vA) {                                                                            \
+    return vsub(vor(vshr52(vA), vset(4503599627370496.0)), vset(4503599627370496.0));                                  \
+}                                                                                                                      \
+/* mantissa of a value, in [1, 2) */                                                                                   \
+TARGET inline vec vmantissa(const vec vA) {                                                                            \
+    return vor(vand(vA, vsetbits(0x000FFFFFFFFFFFFFULL)), vset(1.0));                                                  \
+}                                                                                                                      \
+/* sum of two values without rounding error, vS + vE == vA + vB */                                                     \
+TARGET inline void vtwosum(const vec vA, const vec vB, vec& vS, vec& vE) {                                             \
+    vS             = vadd(vA, vB);                                                                                     \
+    const vec bb   = vsub(vS, vA);                                                                                     \
+    vE             = vadd(vsub(vA, vsub(vS, bb)), vsub(vB, bb));                                                       \
+}                                                                                                                      \
+/* same as vtwosum, for |vA| >= |vB| */                                                                                \
+TARGET inline void vfasttwosum(const vec vA, const vec vB, vec& vS, vec& vE) {                                         \
+    vS = vadd(vA, vB);                                                                                                 \
+    vE = vsub(vB, vsub(vS, vA));                                                                                       \
+}                                                                                                                      \
+/* product of two values without rounding error, vP + vE == vA * vB, for |vA|, |vB| < 2^995 */                         \
+TARGET inline void vtwoprod(const vec vA, const vec vB, vec& vP, vec& vE) {                                            \
+    const vec split = vset(134217729.0);                                                                               \
+    const vec ta    = vmul(vA, split);                                                                                 \
+    const vec ah    = vsub(ta, vsub(ta, vA));                                                                          \
+    const vec al    = vsub(vA, ah);                                                                                    \
+    const vec tb    = vmul(vB, split);                                                                                 \
+    const vec bh    = vsub(tb, vsub(tb, vB));                                                                          \
+    const vec bl    = vsub(vB, bh);                                                                                    \
+    vP              = vmul(vA, vB);                                                                                    \
+    vE              = vadd(vadd(vadd(vsub(vmul(ah, bh), vP), vmul(ah, bl)), vmul(al, bh)), vmul(al, bl));              \
+}                                                                                                                      \
+/* exp(vHi + vLo), with vLo small compared to vHi */                                                                   \
+TARGET inline vec vexpdd(const vec vHi, const vec vLo) {                                                               \
+    const vec x = vmin(vmax(vHi, vset(-750.0)), vset(710.0));                                                          \
+    const vec n = vround(vmul(x, vset(1.4426950408889634)));                                                           \
+    vec rh, rl;                                                                                                        \
+    vtwosum(vsub(x, vmul(n, vset(6.93147180369123816490e-01))), vmul(n, vset(-1.90821492927058770002e-10)), rh, rl);   \
+    const vec r = vadd(rh, vadd(rl, vLo));                                                                             \
+    /* exp(r) - 1 - r, taylor series exact to 2^-60 for |r| <= ln(2) / 2 */                                            \
+    vec p = vset(1.0 / 6227020800.0);                                                                                  \
+    p     = vadd(vmul(p, r), vset(1.0 / 479001600.0));                                                                 \
+    p     = vadd(vmul(p, r), vset(1.0 / 39916800.0));                                                                  \
+    p     = vadd(vmul(p, r), vset(1.0 / 3628800.0));                                                                   \
+    p     = vadd(vmul(p, r), vset(1.0 / 362880.0));                                                                    \
+    p     = vadd(vmul(p, r), vset(1.0 / 40320.0));                                                                     \
+    p     = vadd(vmul(p, r), vset(1.0 / 5040.0));                                                                      \
+    p     = vadd(vmul(p, r), vset(1.0 / 720.0));                                                                       \
+    p     = vadd(vmul(p, r), vset(1.0 / 120.0));                                                                       \
+    p     = vadd(vmul(p, r), vset(1.0 / 24.0));                                                                        \
+    p     = vadd(vmul(p, r), vset(1.0 / 6.0));                                                                         \
+    p     = vadd(vmul(p, r), vset(0.5));                                                                               \
+    p     = vadd(vset(1.0), vadd(r, vmul(vmul(r, r), p)));                                                             \
+    /* 2^n is applied in two steps, for the results near the overflow and the subnormal results */                     \
+    const vec n1 = vround(vmul(n, vset(0.5)));                                                                         \
+    vec res      = vmul(vmul(p, vpow2i(n1)), vpow2i(vsub(n, n1)));                                                     \
+    res          = vselect(vgt(vHi, vset(709.782712893384)), vset(::std::numeric_limits<double>::infinity()), res);    \
+    return vselect(vlt(vHi, vset(-745.1332191019412)), vset(0.0), res);                                                \
+}                                                                                                                      \
+/* log(vA) as vHi + vLo with a relative error below 2^-63, for vA > 0 finite */                                        \
+TARGET inline void vlogdd(const vec vA, vec& vHi, vec& vLo) {                                                          \
+    const vec isSub = vlt(vA, vset(2.2250738585072014e-308));                                                          \
+    const vec x     = vselect(isSub, vmul(vA, vset(4503599627370496.0)), vA);                                          \
+    vec e           = vsub(vsub(vexponent(x), vset(1023.0)), vand(isSub, vset(52.0)));                                 \
+    vec m           = vmantissa(x);                                                                                    \
+    const vec isBig = vgt(m, vset(1.4142135623730951));                                                                \
+    m               = vselect(isBig, vmul(m, vset(0.5)), m);                                                           \
+    e               = vadd(e, vand(isBig, vset(1.0)));                                                                 \
+    /* log(m) = 2 * atanh(s), with s = (m - 1) / (m + 1) in [-0.172, 0.172] */                                         \
+    const vec f = vsub(m, vset(1.0));                                                                                  \
+    vec dh, dl, ph, pl;                                                                                                \
+    vtwosum(m, vset(1.0), dh, dl);                                                                                     \
+    const vec sh = vdiv(f, dh);                                                                                        \
+    vtwoprod(sh, dh, ph, pl);                                                                                          \
+    const vec sl = vdiv(vsub(vsub(vsub(f, ph), pl), vmul(sh, dl)), dh);                                                \
+    /* s^3 * 2 / 3 in double double */                                                                                 \
+    vec uh, ul, ch, cl, th, tl;                                                                                        \
+    vtwoprod(sh, sh, uh, ul);                                                                                          \
+    ul = vadd(ul, vmul(vadd(sh, sh), sl));                                                                             \
+    vtwoprod(uh, sh, ch, cl);                                                                                          \
+    cl = vadd(cl, vadd(vmul(ul, sh), vmul(uh, sl)));                                                                   \
+    vtwoprod(ch, vset(0.66666666666666663), th, tl);                                                                   \
+    tl = vadd(tl, vadd(vmul(cl, vset(0.66666666666666663)), vmul(ch, vset(3.7007434154171883e-17))));                  \
+    /* s^5 * (2 / 5 + 2 * s^2 / 7 + ...) */                                                                            \
+    vec q = vset(2.0 / 23.0);                                                                                          \
+    q     = vadd(vmul(q, uh), vset(2.0 / 21.0));                                                                       \
+    q     = vadd(vmul(q, uh), vset(2.0 / 19.0));                                                                       \
+    q     = vadd(vmul(q, uh), vset(2.0 / 17.0));                                                                       \
+    q     = vadd(vmul(q, uh), vset(2.0 / 15.0));                                                                       \
+    q     = vadd(vmul(q, uh), vset(2.0 / 13.0));                                                                       \
+    q     = vadd(vmul(q, uh), vset(2.0 / 11.0));                                                                       \
+    q     = vadd(vmul(q, uh), vset(2.0 / 9.0));                                                                        \
+    q     = vadd(vmul(q, uh), vset(2.0 / 7.0));                                                                        \
+    q     = vadd(vmul(q, uh), vset(2.0 / 5.0));                                                                        \
+    q     = vmul(vmul(ch, uh), q);                                                                                     \
+    /* e * ln(2) + 2 * s + s^3 * 2 / 3 + s^5 * q */                                                                    \
+    vec hi, lo, t;                                                                                                     \
+    vtwosum(vadd(sh, sh), th, hi, t);                                                                                  \
+    lo = vadd(vadd(vadd(sl, sl), vadd(tl, q)), t);                                                                     \
+    vtwosum(vmul(e, vset(6.93147180369123816490e-01)), hi, hi, t);                                                     \
+    lo = vadd(vadd(lo, t), vmul(e, vset(1.90821492927058770002e-10)));                                                 \
+    vfasttwosum(hi, lo, vHi, vLo);                                                                                     \
+}                                                                                                                      \
+/* log(vA) multiplied by the constant vCh + vCl, NaN for vA < 0 and -Inf for vA == 0 like ::std::log */                \
+TARGET inline vec vlogscaled(const vec vA, const vec vCh, const vec vCl) {                                             \
+    vec hi, lo, ph, pl;                                                                                                \
+    vlogdd(vA, hi, lo);                                                                                                \
+    vtwoprod(hi, vCh, ph, pl);                                                                                         \
+    vec res = vadd(ph, vadd(pl, vadd(vmul(hi, vCl), vmul(lo, vCh))));                                                  \
+    res     = vselect(veq(vA, vset(0.0)), vset(-::std::numeric_limits<double>::infinity()), res);                      \
+    return vselect(vlt(vA, vset(0.0)), vset(::std::numeric_limits<double>::quiet_NaN()), res);                         \
+}                                                                                                                      \
+TARGET inline vec vexp(const vec vA) {                                                                                 \
+    return vexpdd(vA, vset(0.0));                                                                                      \
+}                                                                                                                      \
+TARGET inline vec vlog(const vec vA) {                                                                                 \
+    return vlogscaled(vA, vset(1.0), vset(0.0));                                                                       \
+}                                                                                                                      \
+TARGET inline vec vlog2(const vec vA) {                                                                                \
+    return vlogscaled(vA, vset(1.4426950408889634), vset(2.0355273740931033e-17));                                     \
+}                                                                                                                      \
+TARGET inline vec vlog10(const vec vA) {                                                                               \
+    return vlogscaled(vA, vset(0.4342944819032518), vset(1.098319650216765e-17));                                      \
+}                                                                                                                      \
+/* vA^vB for vA > 0 */                                                                                                 \
+TARGET inline vec vpow(const vec vA, const vec vB) {                                                                   \
+    vec lh, ll, yh, yl;                                                                                                \
+    vlogdd(vA, lh, ll);                                                                                                \
+    vtwoprod(vB, lh, yh, yl);                                                                                          \
+    return vexpdd(yh, vadd(yl, vmul(vB, ll)));                                                                         \
+}                                                                                                                      \
+/* the negative or zero bases, the huge exponents and the non finite values are computed by ::std::pow */              \
+TARGET inline vec vpowspecial(const vec vA, const vec vB) {                                                            \
+    return vor(vor(vge(vset(0.0), vA), vgt(vabs(vB), vset(18446744073709551616.0))), vnotfinite(vA, vB));              \
+}                                                                                                                      \
+/* reduction of vA by pi / 2 as vHi + vLo, with the quadrant in vQ, for |vA| <= 1e5 */                                 \
+TARGET inline void vreducepio2(const vec vA, vec& vHi, vec& vLo, vec& vQ) {                                            \
+    const vec n = vround(vmul(vA, vset(6.36619772367581382433e-01)));                                                  \
+    vec s, e1, e2;                                                                                                     \
+    vtwosum(vsub(vA, vmul(n, vset(1.57079632673412561417e+00))), vmul(n, vset(-6.07710050630396597660e-11)), s, e1);   \
+    vtwosum(s, vmul(n, vset(-2.02226624871116645580e-21)), s, e2);                                                     \
+    const vec lo = vsub(vadd(e1, e2), vmul(n, vset(8.47842766036889956997e-32)));                                      \
+    vfasttwosum(s, lo, vHi, vLo);                                                                                      \
+    const vec m = vsub(n, vmul(vset(4.0), vround(vmul(n, vset(0.25)))));                                               \
+    vQ          = vadd(m, vand(vlt(m, vset(0.0)), vset(4.0)));                                                         \
+}                                                                                                                      \
+/* sin(vHi + vLo) for |vHi| <= pi / 4 */                                                                               \
+TARGET inline vec vsinkernel(const vec vHi, const vec vLo) {                                                           \
+    const vec z = vmul(vHi, vHi);                                                                                      \
+    const vec v = vmul(z, vHi);                                                                                        \
+    vec r       = vset(1.58969099521155010221e-10);                                                                    \
+    r           = vadd(vmul(r, z), vset(-2.50507602534068634195e-08));                                                 \
+    r           = vadd(vmul(r, z), vset(2.75573137070700676789e-06));                                                  \
+    r           = vadd(vmul(r, z), vset(-1.98412698298579493134e-04));                                                 \
+    r           = vadd(vmul(r, z), vset(8.33333333332248946124e-03));                                                  \
+    return vsub(vHi, vsub(vsub(vmul(z, vsub(vmul(vset(0.5), vLo), vmul(v, r))), vLo), vmul(v, vset(-1.66666666666666324348e-01)))); \
+}                                                                                                                      \
+/* cos(vHi + vLo) for |vHi| <= pi / 4 */                                                                               \
+TARGET inline vec vcoskernel(const vec vHi, const vec vLo) {                                                           \
+    const vec z  = vmul(vHi, vHi);                                                                                     \
+    const vec w  = vmul(z, z);                                                                                         \
+    const vec r1 = vmul(z, vadd(vset(4.16666666666666019037e-02), vmul(z, vadd(vset(-1.38888888888741095749e-03), vmul(z, vset(2.48015872894767294178e-05)))))); \
+    const vec r2 = vadd(vset(-2.75573143513906633035e-07), vmul(z, vadd(vset(2.08757232129817482790e-09), vmul(z, vset(-1.13596475577881948265e-11))))); \
+    const vec r  = vadd(r1, vmul(vmul(w, w), r2));                                                                     \
+    const vec hz = vmul(vset(0.5), z);                                                                                 \
+    const vec c  = vsub(vset(1.0), hz);                                                                                \
+    return vadd(c, vadd(vsub(vsub(vset(1.0), c), hz), vsub(vmul(z, r), vmul(vHi, vLo))));                              \
+}                                                                                                                      \
+TARGET inline vec vsin(const vec vA) {                                                                                 \
+    vec hi, lo, q;                                                                                                     \
+    vreducepio2(vA, hi, lo, q);                                                                                        \
+    const vec s     = vsinkernel(hi, lo);                                                                              \
+    const vec c     = vcoskernel(hi, lo);                                                                              \
+    const vec isOdd = vor(veq(q, vset(1.0)), veq(q, vset(3.0)));                                                       \
+    const vec res   = vxor(vselect(isOdd, c, s), vand(vge(q, vset(2.0)), vset(-0.0)));                                 \
+    return vselect(vlt(vabs(vA), vset(7.450580596923828e-09)), vA, res);                                               \
+}                                                                                                                      \
+TARGET inline vec vcos(const vec vA) {                                                                                 \
+    vec hi, lo, q;                                                                                                     \
+    vreducepio2(vA, hi, lo, q);                                                                                        \
+    const vec s      = vsinkernel(hi, lo);                                                                             \
+    const vec c      = vcoskernel(hi, lo);                                                                             \
+    const vec isOdd  = vor(veq(q, vset(1.0)), veq(q, vset(3.0)));                                                      \
+    const vec isNeg  = vor(veq(q, vset(1.0)), veq(q, vset(2.0)));                                                      \
+    const vec res    = vxor(vselect(isOdd, s, c), vand(isNeg, vset(-0.0)));                                            \
+    return vselect(vlt(vabs(vA), vset(7.450580596923828e-09)), vset(1.0), res);                                        \
+}                                                                                                                      \
+TARGET inline vec vtan(const vec vA) {                                                                                 \
+    vec hi, lo, q;                                                                                                     \
+    vreducepio2(vA, hi, lo, q);                                                                                        \
+    const vec s     = vsinkernel(hi, lo);                                                                              \
+    const vec c     = vcoskernel(hi, lo);                                                                              \
+    const vec isOdd = vor(veq(q, vset(1.0)), veq(q, vset(3.0)));                                                       \
+    const vec res   = vselect(isOdd, vdiv(vxor(c, vset(-0.0)), s), vdiv(s, c));                                        \
+    return vselect(vlt(vabs(vA), vset(7.450580596923828e-09)), vA, res);                                               \
+}                                                                                                                      \
+/* the huge and non finite values are computed by the functions of the standard library */                             \
+TARGET inline vec vtrigspecial(const vec vA) {                                                                         \
+    return vor(vgt(vabs(vA), vset(1e5)), vnotfinite(vA));                                                              \
+}                                                                                                                      \
+/* atan2(vA, vB) */                                                                                                    \
+TARGET inline vec vatan2(const vec vA, const vec vB) {                                                                 \
+    const vec ay     = vabs(vA);                                                                                       \
+    const vec ax     = vabs(vB);                                                                                       \
+    const vec isSwap = vgt(ay, ax);                                                                                    \
+    const vec num    = vselect(isSwap, ax, ay);                                                                        \
+    const vec den    = vselect(isSwap, ay, ax);                                                                        \
+    const vec a      = vselect(veq(den, vset(0.0)), vset(0.0), vdiv(num, den));                                        \
+    /* atan(a) for a in [0, 1], reduced around 0, 0.5 or 1 */                                                          \
+    const vec isMid  = vge(a, vset(0.4375));                                                                           \
+    const vec isHigh = vge(a, vset(0.6875));                                                                           \
+    vec x            = vselect(isMid, vdiv(vsub(vadd(a, a), vset(1.0)), vadd(vset(2.0), a)), a);                       \
+    x                = vselect(isHigh, vdiv(vsub(a, vset(1.0)), vadd(a, vset(1.0))), x);                               \
+    const vec hi     = vselect(isHigh, vset(7.85398163397448278999e-01), vand(isMid, vset(4.63647609000806093515e-01))); \
+    const vec lo     = vselect(isHigh, vset(3.06161699786838301793e-17), vand(isMid, vset(2.26987774529616870924e-17))); \
+    const vec z      = vmul(x, x);                                                                                     \
+    const vec w      = vmul(z, z);                                                                                     \
+    vec s1           = vset(1.62858201153657823623e-02);                                                               \
+    s1               = vadd(vmul(s1, w), vset(4.97687799461593236017e-02));                                            \
+    s1               = vadd(vmul(s1, w), vset(6.66107313738753120669e-02));                                            \
+    s1               = vadd(vmul(s1, w), vset(9.09088713343650656196e-02));                                            \
+    s1               = vadd(vmul(s1, w), vset(1.42857142725034663711e-01));                                            \
+    s1               = vmul(z, vadd(vmul(s1, w), vset(3.33333333333329318027e-01)));                                   \
+    vec s2           = vset(-3.65315727442169155270e-02);                                                              \
+    s2               = vadd(vmul(s2, w), vset(-5.83357013379057348645e-02));                                           \
+    s2               = vadd(vmul(s2, w), vset(-7.69187620504482999495e-02));                                           \
+    s2               = vadd(vmul(s2, w), vset(-1.11111104054623557880e-01));                                           \
+    s2               = vmul(w, vadd(vmul(s2, w), vset(-1.99999999998764832476e-01)));                                  \
+    vec res          = vsub(hi, vsub(vsub(vmul(x, vadd(s1, s2)), lo), x));                                             \
+    /* quadrants */                                                                                                    \
+    res              = vselect(isSwap, vsub(vset(1.57079632679489655800e+00), vsub(res, vset(6.12323399573676603587e-17))), res); \
+    const vec isNegX = vor(vlt(vB, vset(0.0)), vand(veq(vB, vset(0.0)), vlt(vdiv(vset(1.0), vB), vset(0.0))));         \
+    res              = vselect(isNegX, vsub(vset(3.14159265358979311600e+00), vsub(res, vset(1.22464679914735317720e-16))), res); \
+    return vcopysign(res, vA);                                                                                         \
+}
 
-        // Initialization of common binary functions
-        addFunction("mod", [](double a, double b) { return ::std::fmod(a, b); });
-        addFunction("pow",
-                    [](double a, double b) { 
-            if (a < 0.0) {
-                throw ExprException(ErrorCode::EVALUATION_NAN, "Pow base value is negative");
-            }
-            return ::std::pow(a, b); });
-        addFunction("atan2", [](double a, double b) { return ::std::atan2(a, b); });
-        addFunction("min", [this](double a, double b) { return m_Min(a, b); });
-        addFunction("max", [this](double a, double b) { return m_Max(a, b); });
-        addFunction("step", [this](double a, double b) { return m_Step(a, b); });
-        addFunction("hypot", [](double a, double b) { return ::std::hypot(a, b); });
-        addFunction("smoothabs", [this](double a, double b) { return m_SmoothAbs(a, b); });
+// Kernels applying a math function to blocks, the special values are computed by the standard library
+#define EZ_SIMD_MATH_UNARY_KERNEL(NAME, TARGET, WIDTH, SPECIAL)                                                        \
+    TARGET inline void NAME(double* vA, size_t vCount) {                                                               \
+        size_t idx = 0;                                                                                                \
+        for (; idx + WIDTH <= vCount; idx += WIDTH) {                                                                  \
+            const vec a = vload(vA + idx);                                                                             \
+            vstore(vA + idx, v##NAME(a));                                                                              \
+            if (vany(SPECIAL(a))) {                                                                                    \
+                double values[WIDTH];                                                                                  \
+                vstore(values, a);                                                                                     \
+                for (size_t lane = 0; lane < WIDTH; ++lane) {                                                          \
+                    if (scalar::vany(scalar::SPECIAL(values[lane]))) {                                                 \
+                        vA[idx + lane] = ::std::NAME(values[lane]);                                                    \
+                    }                                                                                                  \
+                }                                                                                                      \
+            }                                                                                                          \
+        }                                                                                                              \
+        if (idx < vCount) {                                                                                            \
+            scalar::NAME(vA + idx, vCount - idx);                                                                      \
+        }                                                                                                              \
+    }
 
-        // Initialization of common ternary functions
-        addFunction("clamp", [this](double a, double b, double c) { return m_Clamp(a, b, c); });
-        addFunction("lerp", [this](double a, double b, double c) { return m_Mix(a, b, c); });
-        addFunction("mix", [this](double a, double b, double c) { return m_Mix(a, b, c); });
-        addFunction("smoothstep", [this](double a, double b, double c) { return m_SmoothStep(a, b, c); });
+#define EZ_SIMD_MATH_BINARY_KERNEL(NAME, TARGET, WIDTH, SPECIAL)                                                       \
+    TARGET inline void NAME(double* vA, const double* vB, size_t vCount) {                                             \
+        size_t idx = 0;                                                                                                \
+        for (; idx + WIDTH <= vCount; idx += WIDTH) {                                                                  \
+            const vec a = vload(vA + idx);                                                                             \
+            const vec b = vload(vB + idx);                                                                             \
+            vstore(vA + idx, v##NAME(a, b));                                                                           \
+            if (vany(SPECIAL(a, b))) {                                                                                 \
+                double values[WIDTH];                                                                                  \
+                vstore(values, a);                                                                                     \
+                for (size_t lane = 0; lane < WIDTH; ++lane) {                                                          \
+                    if (scalar::vany(scalar::SPECIAL(values[lane], vB[idx + lane]))) {                                 \
+                        vA[idx + lane] = ::std::NAME(values[lane], vB[idx + lane]);                                    \
+                    }                                                                                                  \
+                }                                                                                                      \
+            }                                                                                                          \
+        }                                                                                                              \
+        if (idx < vCount) {                                                                                            \
+            scalar::NAME(vA + idx, vB + idx, vCount - idx);                                                            \
+        }                                                                                                              \
     }
 
-    // Method to parse an expression
-    Expr& parse(const String& vExpr) {
-        m_Expr = vExpr;                            // Store the expression
-        m_ParsedVariables.clear();                 // clearing discoverd vairable during parsing
-        auto tokens = m_tokenize(m_Expr.c_str());  // Tokenize the expression
-        size_t pos  = 0;
-        m_RootExpr  = m_parseExpression(tokens, pos, 0);  // Parse the expression to create the syntax tree
+#define EZ_SIMD_MATH_KERNELS(TARGET, WIDTH)                              \
+    EZ_SIMD_MATH_FUNCTIONS(TARGET)                                       \
+    EZ_SIMD_MATH_UNARY_KERNEL(exp, TARGET, WIDTH, vnotfinite)            \
+    EZ_SIMD_MATH_UNARY_KERNEL(log, TARGET, WIDTH, vnotfinite)            \
+    EZ_SIMD_MATH_UNARY_KERNEL(log2, TARGET, WIDTH, vnotfinite)           \
+    EZ_SIMD_MATH_UNARY_KERNEL(log10, TARGET, WIDTH, vnotfinite)          \
+    EZ_SIMD_MATH_UNARY_KERNEL(sin, TARGET, WIDTH, vtrigspecial)          \
+    EZ_SIMD_MATH_UNARY_KERNEL(cos, TARGET, WIDTH, vtrigspecial)          \
+    EZ_SIMD_MATH_UNARY_KERNEL(tan, TARGET, WIDTH, vtrigspecial)          \
+    EZ_SIMD_MATH_BINARY_KERNEL(atan2, TARGET, WIDTH, vnotfinite)         \
+    EZ_SIMD_MATH_BINARY_KERNEL(pow, TARGET, WIDTH, vpowspecial)
 
-        // Check for remaining tokens after parsing
-        if (pos < tokens.size()) {
-            // If the next token is an unmatched closing parenthesis
-            if (tokens[pos].value == ")") {
-                throw ExprException(ErrorCode::UNMATCHED_PARENTHESIS, "Unmatched parenthesis found at the end of the expression.");
-            }
-            // If other tokens remain, which is also abnormal
-            throw ExprException(ErrorCode::PARSE_ERROR, "Unexpected token found after complete parsing.");
-        }
+namespace scalar {
 
-        return *this;
+inline void add(double* vA, const double* vB, size_t vCount) {
+    for (size_t idx = 0; idx < vCount; ++idx) {
+        vA[idx] = vA[idx] + vB[idx];
     }
+}
 
-    // Method to set the value of a variable
-    Expr& set(const String& vName, const double vValue, const bool vIfNotExist = false) {
-        if (vIfNotExist) {
-            if (m_DefinedVariables.find(vName) != m_DefinedVariables.end()) {  // If exists
-                return *this;
-            }
-        }
-        m_DefinedVariables[vName] = vValue;
-        return *this;
+inline void sub(double* vA, const double* vB, size_t vCount) {
+    for (size_t idx = 0; idx < vCount; ++idx) {
+        vA[idx] = vA[idx] - vB[idx];
     }
+}
 
-    // Method to evaluate the expression
-    Expr& eval() {
-        m_evalNode(m_RootExpr, m_EvalResult);  // Evaluate the root of the syntax tree
-        return *this;
+inline void mul(double* vA, const double* vB, size_t vCount) {
+    for (size_t idx = 0; idx < vCount; ++idx) {
+        vA[idx] = vA[idx] * vB[idx];
     }
+}
 
-    Expr& startTime() {
-        m_StartTime = ::std::chrono::steady_clock::now();  // Start time
-        return *this;
+inline void div(double* vA, const double* vB, size_t vCount) {
+    for (size_t idx = 0; idx < vCount; ++idx) {
+        vA[idx] = vA[idx] / vB[idx];
     }
+}
 
-    Expr& endTime() {
-        m_EndTime = ::std::chrono::steady_clock::now();  // End time
-        return *this;
+inline void min(double* vA, const double* vB, size_t vCount) {
+    for (size_t idx = 0; idx < vCount; ++idx) {
+        vA[idx] = vA[idx] < vB[idx] ? vA[idx] : vB[idx];
     }
+}
 
-    // Returns the evaluation time in milliseconds
-    double getEvalTime() {
-        m_Elapsed = m_EndTime - m_StartTime;
-        return m_Elapsed.count();
+inline void max(double* vA, const double* vB, size_t vCount) {
+    for (size_t idx = 0; idx < vCount; ++idx) {
+        vA[idx] = vA[idx] > vB[idx] ? vA[idx] : vB[idx];
     }
+}
 
-    // Method to add a constant
-    Expr& addConstant(const String& vName, const double vValue) {
-        m_Constant[vName] = vValue;  // Add the constant
-        return *this;
+// vA is the edge, vB the value
+inline void step(double* vA, const double* vB, size_t vCount) {
+    for (size_t idx = 0; idx < vCount; ++idx) {
+        vA[idx] = vB[idx] < vA[idx] ? 0.0 : 1.0;
     }
+}
 
-    // Method to add a unary function
-    Expr& addFunction(const String& vName, const UnaryFunctor& functor) {
-        Function fun;
-        fun.unaryFunctor   = functor;
-        fun.argCount       = 1;
-        m_Functions[vName] = fun;
-        return *this;
+inline void neg(double* vA, size_t vCount) {
+    for (size_t idx = 0; idx < vCount; ++idx) {
+        vA[idx] = -vA[idx];
     }
+}
 
-    // Method to add a binary function
-    Expr& addFunction(const String& vName, const BinaryFunctor& functor) {
-        Function fun;
-        fun.binaryFunctor  = functor;
-        fun.argCount       = 2;
-        m_Functions[vName] = fun;
-        return *this;
+inline void abs(double* vA, size_t vCount) {
+    for (size_t idx = 0; idx < vCount; ++idx) {
+        vA[idx] = ::std::abs(vA[idx]);
     }
+}
 
-    // Method to add a ternary function
-    Expr& addFunction(const String& vName, const TernaryFunctor& functor) {
-        Function fun;
+inline void sqrt(double* vA, size_t vCount) {
+    for (size_t idx = 0; idx < vCount; ++idx) {
+        vA[idx] = ::std::sqrt(vA[idx]);
+    }
+}
+
+inline void sign(double* vA, size_t vCount) {
+    for (size_t idx = 0; idx < vCount; ++idx) {
+        vA[idx] = static_cast<double>((vA[idx] > 0.0) - (vA[idx] < 0.0));
+    }
+}
+
+inline void fract(double* vA, size_t vCount) {
+    for (size_t idx = 0; idx < vCount; ++idx) {
+        vA[idx] = vA[idx] - ::std::floor(vA[idx]);
+    }
+}
+
+inline void saturate(double* vA, size_t vCount) {
+    for (size_t idx = 0; idx < vCount; ++idx) {
+        const double v = vA[idx] > 0.0 ? vA[idx] : 0.0;
+        vA[idx]        = v < 1.0 ? v : 1.0;
+    }
+}
+
+// vA is the value, vB the min, vC the max
+inline void clamp(double* vA, const double* vB, const double* vC, size_t vCount) {
+    for (size_t idx = 0; idx < vCount; ++idx) {
+        const double v = vA[idx] > vB[idx] ? vA[idx] : vB[idx];
+        vA[idx]        = v < vC[idx] ? v : vC[idx];
+    }
+}
+
+// vA and vB are mixed by vC
+inline void mix(double* vA, const double* vB, const double* vC, size_t vCount) {
+    for (size_t idx = 0; idx < vCount; ++idx) {
+        vA[idx] = vA[idx] * (1.0 - vC[idx]) + vB[idx] * vC[idx];
+    }
+}
+
+// vA and vB are the edges, vC the value
+inline void smoothstep(double* vA, const double* vB, const double* vC, size_t vCount) {
+    for (size_t idx = 0; idx < vCount; ++idx) {
+        double t = (vC[idx] - vA[idx]) / (vB[idx] - vA[idx]);
+        t        = t > 0.0 ? t : 0.0;
+        t        = t < 1.0 ? t : 1.0;
+        vA[idx]  = t * t * (3.0 - 2.0 * t);
+    }
+}
+
+inline bool hasZero(const double* vA, size_t vCount) {
+    for (size_t idx = 0; idx < vCount; ++idx) {
+        if (vA[idx] == 0.0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool hasNanOrInf(const double* vA, size_t vCount) {
+    for (size_t idx = 0; idx < vCount; ++idx) {
+        if (::std::isnan(vA[idx]) || ::std::isinf(vA[idx])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+// Primitives of the math functions, a mask is a value with all its bits set or none
+typedef double vec;
+
+inline vec vfrombits(const uint64_t vBits) {
+    double value;
+    ::std::memcpy(&value, &vBits, sizeof(value));
+    return value;
+}
+
+inline uint64_t vtobits(const vec vA) {
+    uint64_t bits;
+    ::std::memcpy(&bits, &vA, sizeof(bits));
+    return bits;
+}
+
+inline vec vmask(const bool vIsSet) {
+    return vfrombits(vIsSet ? ~0ULL : 0ULL);
+}
+
+inline vec vset(const double vA) { return vA; }
+inline vec vsetbits(const uint64_t vBits) { return vfrombits(vBits); }
+inline vec vload(const double* vPtr) { return *vPtr; }
+inline void vstore(double* vPtr, const vec vA) { *vPtr = vA; }
+inline vec vadd(const vec vA, const vec vB) { return vA + vB; }
+inline vec vsub(const vec vA, const vec vB) { return vA - vB; }
+inline vec vmul(const vec vA, const vec vB) { return vA * vB; }
+inline vec vdiv(const vec vA, const vec vB) { return vA / vB; }
+inline vec vmin(const vec vA, const vec vB) { return vA < vB ? vA : vB; }
+inline vec vmax(const vec vA, const vec vB) { return vA > vB ? vA : vB; }
+inline vec vand(const vec vA, const vec vB) { return vfrombits(vtobits(vA) & vtobits(vB)); }
+inline vec vor(const vec vA, const vec vB) { return vfrombits(vtobits(vA) | vtobits(vB)); }
+inline vec vxor(const vec vA, const vec vB) { return vfrombits(vtobits(vA) ^ vtobits(vB)); }
+inline vec vandnot(const vec vA, const vec vB) { return vfrombits(~vtobits(vA) & vtobits(vB)); }
+inline vec vlt(const vec vA, const vec vB) { return vmask(vA < vB); }
+inline vec vgt(const vec vA, const vec vB) { return vmask(vA > vB); }
+inline vec vge(const vec vA, const vec vB) { return vmask(vA >= vB); }
+inline vec veq(const vec vA, const vec vB) { return vmask(vA == vB); }
+inline bool vany(const vec vMask) { return vtobits(vMask) != 0ULL; }
+inline vec vshl52(const vec vA) { return vfrombits(vtobits(vA) << 52); }
+inline vec vshr52(const vec vA) { return vfrombits(vtobits(vA) >> 52); }
+
+EZ_SIMD_MATH_KERNELS(, 1U)
+
+}  // namespace scalar
+
+#ifdef USE_SIMD_KERNELS
+
+// the values not filling a whole register are computed by the scalar kernels
+#define EZ_SIMD_BINARY_KERNEL(NAME, TARGET, VEC, WIDTH, LOAD, STORE, EXPR)   \
+    TARGET inline void NAME(double* vA, const double* vB, size_t vCount) { \
+        size_t idx = 0;                                                     \
+        for (; idx + WIDTH <= vCount; idx += WIDTH) {                       \
+            const VEC a = LOAD(vA + idx);                                   \
+            const VEC b = LOAD(vB + idx);                                   \
+            STORE(vA + idx, EXPR);                                          \
+        }                                                                   \
+        scalar::NAME(vA + idx, vB + idx, vCount - idx);                     \
+    }
+
+#define EZ_SIMD_UNARY_KERNEL(NAME, TARGET, VEC, WIDTH, LOAD, STORE, EXPR) \
+    TARGET inline void NAME(double* vA, size_t vCount) {                \
+        size_t idx = 0;                                                  \
+        for (; idx + WIDTH <= vCount; idx += WIDTH) {                    \
+            const VEC a = LOAD(vA + idx);                                \
+            STORE(vA + idx, EXPR);                                       \
+        }                                                                \
+        scalar::NAME(vA + idx, vCount - idx);                            \
+    }
+
+#define EZ_SIMD_TERNARY_KERNEL(NAME, TARGET, VEC, WIDTH, LOAD, STORE, EXPR)                      \
+    TARGET inline void NAME(double* vA, const double* vB, const double* vC, size_t vCount) { \
+        size_t idx = 0;                                                                         \
+        for (; idx + WIDTH <= vCount; idx += WIDTH) {                                           \
+            const VEC a = LOAD(vA + idx);                                                       \
+            const VEC b = LOAD(vB + idx);                                                       \
+            const VEC c = LOAD(vC + idx);                                                       \
+            STORE(vA + idx, EXPR);                                                              \
+        }                                                                                       \
+        scalar::NAME(vA + idx, vB + idx, vC + idx, vCount - idx);                               \
+    }
+
+namespace sse2 {
+
+#define EZ_SSE2_BINARY(NAME, EXPR) EZ_SIMD_BINARY_KERNEL(NAME, , __m128d, 2U, _mm_loadu_pd, _mm_storeu_pd, EXPR)
+#define EZ_SSE2_UNARY(NAME, EXPR) EZ_SIMD_UNARY_KERNEL(NAME, , __m128d, 2U, _mm_loadu_pd, _mm_storeu_pd, EXPR)
+#define EZ_SSE2_TERNARY(NAME, EXPR) EZ_SIMD_TERNARY_KERNEL(NAME, , __m128d, 2U, _mm_loadu_pd, _mm_storeu_pd, EXPR)
+
+typedef __m128d vec;
+
+inline vec vset(const double vA) { return _mm_set1_pd(vA); }
+inline vec vsetbits(const uint64_t vBits) { return _mm_castsi128_pd(_mm_set1_epi64x(static_cast<long long>(vBits))); }
+inline vec vload(const double* vPtr) { return _mm_loadu_pd(vPtr); }
+inline void vstore(double* vPtr, const vec vA) { _mm_storeu_pd(vPtr, vA); }
+inline vec vadd(const vec vA, const vec vB) { return _mm_add_pd(vA, vB); }
+inline vec vsub(const vec vA, const vec vB) { return _mm_sub_pd(vA, vB); }
+inline vec vmul(const vec vA, const vec vB) { return _mm_mul_pd(vA, vB); }
+inline vec vdiv(const vec vA, const vec vB) { return _mm_div_pd(vA, vB); }
+inline vec vmin(const vec vA, const vec vB) { return _mm_min_pd(vA, vB); }
+inline vec vmax(const vec vA, const vec vB) { return _mm_max_pd(vA, vB); }
+inline vec vand(const vec vA, const vec vB) { return _mm_and_pd(vA, vB); }
+inline vec vor(const vec vA, const vec vB) { return _mm_or_pd(vA, vB); }
+inline vec vxor(const vec vA, const vec vB) { return _mm_xor_pd(vA, vB); }
+inline vec vandnot(const vec vA, const vec vB) { return _mm_andnot_pd(vA, vB); }
+inline vec vlt(const vec vA, const vec vB) { return _mm_cmplt_pd(vA, vB); }
+inline vec vgt(const vec vA, const vec vB) { return _mm_cmpgt_pd(vA, vB); }
+inline vec vge(const vec vA, const vec vB) { return _mm_cmpge_pd(vA, vB); }
+inline vec veq(const vec vA, const vec vB) { return _mm_cmpeq_pd(vA, vB); }
+inline bool vany(const vec vMask) { return _mm_movemask_pd(vMask) != 0; }
+inline vec vshl52(const vec vA) { return _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(vA), 52)); }
+inline vec vshr52(const vec vA) { return _mm_castsi128_pd(_mm_srli_epi64(_mm_castpd_si128(vA), 52)); }
+
+EZ_SIMD_MATH_KERNELS(, 2U)
+
+inline __m128d clamp01(const __m128d vA) {
+    return _mm_min_pd(_mm_max_pd(vA, _mm_setzero_pd()), _mm_set1_pd(1.0));
+}
+
+EZ_SSE2_BINARY(add, _mm_add_pd(a, b))
+EZ_SSE2_BINARY(sub, _mm_sub_pd(a, b))
+EZ_SSE2_BINARY(mul, _mm_mul_pd(a, b))
+EZ_SSE2_BINARY(div, _mm_div_pd(a, b))
+EZ_SSE2_BINARY(min, _mm_min_pd(a, b))  // a < b ? a : b, like the scalar code
+EZ_SSE2_BINARY(max, _mm_max_pd(a, b))  // a > b ? a : b, like the scalar code
+EZ_SSE2_BINARY(step, _mm_andnot_pd(_mm_cmplt_pd(b, a), _mm_set1_pd(1.0)))
+EZ_SSE2_UNARY(neg, _mm_xor_pd(a, _mm_set1_pd(-0.0)))
+EZ_SSE2_UNARY(abs, _mm_andnot_pd(_mm_set1_pd(-0.0), a))
+EZ_SSE2_UNARY(sqrt, _mm_sqrt_pd(a))
+EZ_SSE2_UNARY(sign, _mm_or_pd(_mm_and_pd(_mm_cmpgt_pd(a, _mm_setzero_pd()), _mm_set1_pd(1.0)), _mm_and_pd(_mm_cmplt_pd(a, _mm_setzero_pd()), _mm_set1_pd(-1.0))))
+EZ_SSE2_UNARY(saturate, clamp01(a))
+EZ_SSE2_TERNARY(clamp, _mm_min_pd(_mm_max_pd(a, b), c))
+EZ_SSE2_TERNARY(mix, _mm_add_pd(_mm_mul_pd(a, _mm_sub_pd(_mm_set1_pd(1.0), c)), _mm_mul_pd(b, c)))
+
+inline void smoothstep(double* vA, const double* vB, const double* vC, size_t vCount) {
+    size_t idx = 0;
+    for (; idx + 2U <= vCount; idx += 2U) {
+        const __m128d a = _mm_loadu_pd(vA + idx);
+        const __m128d t = clamp01(_mm_div_pd(_mm_sub_pd(_mm_loadu_pd(vC + idx), a), _mm_sub_pd(_mm_loadu_pd(vB + idx), a)));
+        _mm_storeu_pd(vA + idx, _mm_mul_pd(_mm_mul_pd(t, t), _mm_sub_pd(_mm_set1_pd(3.0), _mm_mul_pd(_mm_set1_pd(2.0), t))));
+    }
+    scalar::smoothstep(vA + idx, vB + idx, vC + idx, vCount - idx);
+}
+
+inline bool hasZero(const double* vA, size_t vCount) {
+    size_t idx = 0;
+    __m128d found = _mm_setzero_pd();
+    for (; idx + 2U <= vCount; idx += 2U) {
+        found = _mm_or_pd(found, _mm_cmpeq_pd(_mm_loadu_pd(vA + idx), _mm_setzero_pd()));
+    }
+    return _mm_movemask_pd(found) != 0 || scalar::hasZero(vA + idx, vCount - idx);
+}
+
+inline bool hasNanOrInf(const double* vA, size_t vCount) {
+    size_t idx = 0;
+    __m128d found = _mm_setzero_pd();
+    for (; idx + 2U <= vCount; idx += 2U) {
+        const __m128d a = _mm_loadu_pd(vA + idx);
+        const __m128d d = _mm_sub_pd(a, a);  // NaN for NaN and Inf, 0 otherwise
+        found           = _mm_or_pd(found, _mm_cmpunord_pd(d, d));
+    }
+    return _mm_movemask_pd(found) != 0 || scalar::hasNanOrInf(vA + idx, vCount - idx);
+}
+
+}  // namespace sse2
+
+namespace avx2 {
+
+#define EZ_AVX2_BINARY(NAME, EXPR) EZ_SIMD_BINARY_KERNEL(NAME, EZ_TARGET_AVX2, __m256d, 4U, _mm256_loadu_pd, _mm256_storeu_pd, EXPR)
+#define EZ_AVX2_UNARY(NAME, EXPR) EZ_SIMD_UNARY_KERNEL(NAME, EZ_TARGET_AVX2, __m256d, 4U, _mm256_loadu_pd, _mm256_storeu_pd, EXPR)
+#define EZ_AVX2_TERNARY(NAME, EXPR) EZ_SIMD_TERNARY_KERNEL(NAME, EZ_TARGET_AVX2, __m256d, 4U, _mm256_loadu_pd, _mm256_storeu_pd, EXPR)
+
+typedef __m256d vec;
+
+EZ_TARGET_AVX2 inline vec vset(const double vA) { return _mm256_set1_pd(vA); }
+EZ_TARGET_AVX2 inline vec vsetbits(const uint64_t vBits) { return _mm256_castsi256_pd(_mm256_set1_epi64x(static_cast<long long>(vBits))); }
+EZ_TARGET_AVX2 inline vec vload(const double* vPtr) { return _mm256_loadu_pd(vPtr); }
+EZ_TARGET_AVX2 inline void vstore(double* vPtr, const vec vA) { _mm256_storeu_pd(vPtr, vA); }
+EZ_TARGET_AVX2 inline vec vadd(const vec vA, const vec vB) { return _mm256_add_pd(vA, vB); }
+EZ_TARGET_AVX2 inline vec vsub(const vec vA, const vec vB) { return _mm256_sub_pd(vA, vB); }
+EZ_TARGET_AVX2 inline vec vmul(const vec vA, const vec vB) { return _mm256_mul_pd(vA, vB); }
+EZ_TARGET_AVX2 inline vec vdiv(const vec vA, const vec vB) { return _mm256_div_pd(vA, vB); }
+EZ_TARGET_AVX2 inline vec vmin(const vec vA, const vec vB) { return _mm256_min_pd(vA, vB); }
+EZ_TARGET_AVX2 inline vec vmax(const vec vA, const vec vB) { return _mm256_max_pd(vA, vB); }
+EZ_TARGET_AVX2 inline vec vand(const vec vA, const vec vB) { return _mm256_and_pd(vA, vB); }
+EZ_TARGET_AVX2 inline vec vor(const vec vA, const vec vB) { return _mm256_or_pd(vA, vB); }
+EZ_TARGET_AVX2 inline vec vxor(const vec vA, const vec vB) { return _mm256_xor_pd(vA, vB); }
+EZ_TARGET_AVX2 inline vec vandnot(const vec vA, const vec vB) { return _mm256_andnot_pd(vA, vB); }
+EZ_TARGET_AVX2 inline vec vlt(const vec vA, const vec vB) { return _mm256_cmp_pd(vA, vB, _CMP_LT_OQ); }
+EZ_TARGET_AVX2 inline vec vgt(const vec vA, const vec vB) { return _mm256_cmp_pd(vA, vB, _CMP_GT_OQ); }
+EZ_TARGET_AVX2 inline vec vge(const vec vA, const vec vB) { return _mm256_cmp_pd(vA, vB, _CMP_GE_OQ); }
+EZ_TARGET_AVX2 inline vec veq(const vec vA, const vec vB) { return _mm256_cmp_pd(vA, vB, _CMP_EQ_OQ); }
+EZ_TARGET_AVX2 inline bool vany(const vec vMask) { return _mm256_movemask_pd(vMask) != 0; }
+EZ_TARGET_AVX2 inline vec vshl52(const vec vA) { return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(vA), 52)); }
+EZ_TARGET_AVX2 inline vec vshr52(const vec vA) { return _mm256_castsi256_pd(_mm256_srli_epi64(_mm256_castpd_si256(vA), 52)); }
+
+EZ_SIMD_MATH_KERNELS(EZ_TARGET_AVX2, 4U)
+
+EZ_TARGET_AVX2 inline __m256d clamp01(const __m256d vA) {
+    return _mm256_min_pd(_mm256_max_pd(vA, _mm256_setzero_pd()), _mm256_set1_pd(1.0));
+}
+
+EZ_AVX2_BINARY(add, _mm256_add_pd(a, b))
+EZ_AVX2_BINARY(sub, _mm256_sub_pd(a, b))
+EZ_AVX2_BINARY(mul, _mm256_mul_pd(a, b))
+EZ_AVX2_BINARY(div, _mm256_div_pd(a, b))
+EZ_AVX2_BINARY(min, _mm256_min_pd(a, b))
+EZ_AVX2_BINARY(max, _mm256_max_pd(a, b))
+EZ_AVX2_BINARY(step, _mm256_andnot_pd(_mm256_cmp_pd(b, a, _CMP_LT_OQ), _mm256_set1_pd(1.0)))
+EZ_AVX2_UNARY(neg, _mm256_xor_pd(a, _mm256_set1_pd(-0.0)))
+EZ_AVX2_UNARY(abs, _mm256_andnot_pd(_mm256_set1_pd(-0.0), a))
+EZ_AVX2_UNARY(sqrt, _mm256_sqrt_pd(a))
+EZ_AVX2_UNARY(sign, _mm256_or_pd(_mm256_and_pd(_mm256_cmp_pd(a, _mm256_setzero_pd(), _CMP_GT_OQ), _mm256_set1_pd(1.0)), _mm256_and_pd(_mm256_cmp_pd(a, _mm256_setzero_pd(), _CMP_LT_OQ), _mm256_set1_pd(-1.0))))
+EZ_AVX2_UNARY(fract, _mm256_sub_pd(a, _mm256_floor_pd(a)))
+EZ_AVX2_UNARY(saturate, clamp01(a))
+EZ_AVX2_TERNARY(clamp, _mm256_min_pd(_mm256_max_pd(a, b), c))
+EZ_AVX2_TERNARY(mix, _mm256_add_pd(_mm256_mul_pd(a, _mm256_sub_pd(_mm256_set1_pd(1.0), c)), _mm256_mul_pd(b, c)))
+
+EZ_TARGET_AVX2 inline void smoothstep(double* vA, const double* vB, const double* vC, size_t vCount) {
+    size_t idx = 0;
+    for (; idx + 4U <= vCount; idx += 4U) {
+        const __m256d a = _mm256_loadu_pd(vA + idx);
+        const __m256d t = clamp01(_mm256_div_pd(_mm256_sub_pd(_mm256_loadu_pd(vC + idx), a), _mm256_sub_pd(_mm256_loadu_pd(vB + idx), a)));
+        _mm256_storeu_pd(vA + idx, _mm256_mul_pd(_mm256_mul_pd(t, t), _mm256_sub_pd(_mm256_set1_pd(3.0), _mm256_mul_pd(_mm256_set1_pd(2.0), t))));
+    }
+    scalar::smoothstep(vA + idx, vB + idx, vC + idx, vCount - idx);
+}
+
+EZ_TARGET_AVX2 inline bool hasZero(const double* vA, size_t vCount) {
+    size_t idx = 0;
+    __m256d found = _mm256_setzero_pd();
+    for (; idx + 4U <= vCount; idx += 4U) {
+        found = _mm256_or_pd(found, _mm256_cmp_pd(_mm256_loadu_pd(vA + idx), _mm256_setzero_pd(), _CMP_EQ_OQ));
+    }
+    return _mm256_movemask_pd(found) != 0 || scalar::hasZero(vA + idx, vCount - idx);
+}
+
+EZ_TARGET_AVX2 inline bool hasNanOrInf(const double* vA, size_t vCount) {
+    size_t idx = 0;
+    __m256d found = _mm256_setzero_pd();
+    for (; idx + 4U <= vCount; idx += 4U) {
+        const __m256d a = _mm256_loadu_pd(vA + idx);
+        const __m256d d = _mm256_sub_pd(a, a);  // NaN for NaN and Inf, 0 otherwise
+        found           = _mm256_or_pd(found, _mm256_cmp_pd(d, d, _CMP_UNORD_Q));
+    }
+    return _mm256_movemask_pd(found) != 0 || scalar::hasNanOrInf(vA + idx, vCount - idx);
+}
+
+#undef EZ_AVX2_BINARY
+#undef EZ_AVX2_UNARY
+#undef EZ_AVX2_TERNARY
+#undef EZ_TARGET_AVX2
+
+}  // namespace avx2
+
+#undef EZ_SSE2_BINARY
+#undef EZ_SSE2_UNARY
+#undef EZ_SSE2_TERNARY
+#undef EZ_SIMD_BINARY_KERNEL
+#undef EZ_SIMD_UNARY_KERNEL
+#undef EZ_SIMD_TERNARY_KERNEL
+
+// Returns true if the cpu and the os support AVX2
+inline bool isAvx2Supported() {
+#ifdef _MSC_VER
+    int info[4] = {};
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx     = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif  // USE_SIMD_KERNELS
+
+// defined for all the instruction sets, the scalar one included
+#undef EZ_SIMD_MATH_FUNCTIONS
+#undef EZ_SIMD_MATH_UNARY_KERNEL
+#undef EZ_SIMD_MATH_BINARY_KERNEL
+#undef EZ_SIMD_MATH_KERNELS
+
+// Returns the best instruction set supported by the cpu
+inline InstructionSet getBestInstructionSet() {
+#ifdef USE_SIMD_KERNELS
+    static const InstructionSet s_best = isAvx2Supported() ? InstructionSet::AVX2 : InstructionSet::SSE2;
+    return s_best;
+#else
+    return InstructionSet::SCALAR;
+#endif
+}
+
+// Returns the kernels of an instruction set, or of the best supported one below it
+inline const Kernels& getKernels(InstructionSet vInstructionSet) {
+    static Kernels s_kernels[static_cast<size_t>(InstructionSet::Count)];
+    static bool s_initialized = [] {
+        Kernels& k     = s_kernels[static_cast<size_t>(InstructionSet::SCALAR)];
+        k.add          = scalar::add;
+        k.sub          = scalar::sub;
+        k.mul          = scalar::mul;
+        k.div          = scalar::div;
+        k.min          = scalar::min;
+        k.max          = scalar::max;
+        k.step         = scalar::step;
+        k.neg          = scalar::neg;
+        k.abs          = scalar::abs;
+        k.sqrt         = scalar::sqrt;
+        k.sign         = scalar::sign;
+        k.fract        = scalar::fract;
+        k.saturate     = scalar::saturate;
+        k.clamp        = scalar::clamp;
+        k.mix          = scalar::mix;
+        k.smoothstep   = scalar::smoothstep;
+        k.hasZero      = scalar::hasZero;
+        k.hasNanOrInf  = scalar::hasNanOrInf;
+        s_kernels[static_cast<size_t>(InstructionSet::SSE2)] = k;
+        s_kernels[static_cast<size_t>(InstructionSet::AVX2)] = k;
+#ifdef USE_SIMD_KERNELS
+        Kernels& s      = s_kernels[static_cast<size_t>(InstructionSet::SSE2)];
+        s.instructionSet = InstructionSet::SSE2;
+        s.add           = sse2::add;
+        s.sub           = sse2::sub;
+        s.mul           = sse2::mul;
+        s.div           = sse2::div;
+        s.min           = sse2::min;
+        s.max           = sse2::max;
+        s.step          = sse2::step;
+        s.neg           = sse2::neg;
+        s.abs           = sse2::abs;
+        s.sqrt          = sse2::sqrt;
+        s.sign          = sse2::sign;
+        s.saturate      = sse2::saturate;  // no exact floor in SSE2, fract stays scalar
+        s.clamp         = sse2::clamp;
+        s.mix           = sse2::mix;
+        s.smoothstep    = sse2::smoothstep;
+        s.hasZero       = sse2::hasZero;
+        s.hasNanOrInf   = sse2::hasNanOrInf;
+        s.exp           = sse2::exp;
+        s.log           = sse2::log;
+        s.log2          = sse2::log2;
+        s.log10         = sse2::log10;
+        s.sin           = sse2::sin;
+        s.cos           = sse2::cos;
+        s.tan           = sse2::tan;
+        s.atan2         = sse2::atan2;
+        s.pow           = sse2::pow;
+        Kernels& a      = s_kernels[static_cast<size_t>(InstructionSet::AVX2)];
+        a.instructionSet = InstructionSet::AVX2;
+        a.add           = avx2::add;
+        a.sub           = avx2::sub;
+        a.mul           = avx2::mul;
+        a.div           = avx2::div;
+        a.min           = avx2::min;
+        a.max           = avx2::max;
+        a.step          = avx2::step;
+        a.neg           = avx2::neg;
+        a.abs           = avx2::abs;
+        a.sqrt          = avx2::sqrt;
+        a.sign          = avx2::sign;
+        a.fract         = avx2::fract;
+        a.saturate      = avx2::saturate;
+        a.clamp         = avx2::clamp;
+        a.mix           = avx2::mix;
+        a.smoothstep    = avx2::smoothstep;
+        a.hasZero       = avx2::hasZero;
+        a.hasNanOrInf   = avx2::hasNanOrInf;
+        a.exp           = avx2::exp;
+        a.log           = avx2::log;
+        a.log2          = avx2::log2;
+        a.log10         = avx2::log10;
+        a.sin           = avx2::sin;
+        a.cos           = avx2::cos;
+        a.tan           = avx2::tan;
+        a.atan2         = avx2::atan2;
+        a.pow           = avx2::pow;
+#endif  // USE_SIMD_KERNELS
+        return true;
+    }();
+    (void)s_initialized;
+    if (vInstructionSet > getBestInstructionSet()) {
+        vInstructionSet = getBestInstructionSet();
+    }
+    return s_kernels[static_cast<size_t>(vInstructionSet)];
+}
+
+}  // namespace simd
+
+// Definition of the builtin functions, for the functions needing a known behavior
+enum class BuiltinId : uint8_t {
+    NONE = 0,  // not a builtin
+    ABS,
+    FLOOR,
+    CEIL,
+    ROUND,
+    FRACT,
+    SIGN,
+    SIN,
+    COS,
+    TAN,
+    ASIN,
+    ACOS,
+    ATAN,
+    SINH,
+    COSH,
+    TANH,
+    ASINH,
+    ACOSH,
+    ATANH,
+    LN,
+    LOG,
+    LOG1P,
+    LOGB,
+    LOG2,
+    LOG10,
+    SQRT,
+    EXP,
+    FACT,
+    SATURATE,
+    MOD,
+    POW,
+    ATAN2,
+    MIN,
+    MAX,
+    STEP,
+    HYPOT,
+    SMOOTHABS,
+    CLAMP,
+    LERP,
+    MIX,
+    SMOOTHSTEP,
+    Count
+};
+
+// Structure representing a function with its number of arguments and behavior
+struct Function {
+    UnaryFunctor unaryFunctor     = nullptr;
+    BinaryFunctor binaryFunctor   = nullptr;
+    TernaryFunctor ternaryFunctor = nullptr;
+    size_t argCount               = 0U;
+    bool isPure                   = false;  // same result for same arguments and no side effects, so it can be folded
+    BuiltinId builtin             = BuiltinId::NONE;  // defined by defineDefaultBuiltins, so its behavior is known
+};
+
+// Container to store available functions, an insertion moving its entries (the functions are resolved again after it)
+typedef FlatMap<Function> FunctionContainer;
+
+// Definition of possible token types
+enum class TokenType {
+    NUMBER = 0,
+    LPAREN,
+    RPAREN,
+    VARIABLE,
+    OPERATOR,
+    FUNCTION,
+    SEPARATOR,
+    Count
+};
+
+// Handle on the slot of a variable found during parsing, valid until the next parsing
+struct VarHandle {
+    uint32_t slot = 0U;
+};
+
+// Structure representing a variable bound to a memory owned by the caller
+struct VarBinding {
+    const double* ptr = nullptr;  // bound address
+    size_t offset     = 0U;       // offset from the binding base
+    bool isOffset     = false;    // the variable is bound to an offset from the binding base
+};
+
+// Definition of the instructions executed by the evaluation loop
+// the operators tokens and nodes use the same codes
+enum class OpCode : uint8_t {
+    PUSH_NUMBER = 0,  // push a value of the constants pool
+    PUSH_VARIABLE,    // push the value of a variable
+    ADD,
+    SUB,
+    MUL,
+    DIV,
+    POW,
+    MOD,
+    NEG,           // prefix "-" operator
+    POWI,          // power by a small integer exponent given as argument, emitted by the simplification
+    SQRT,          // square root, emitted by the simplification
+    STORE_TEMP,    // copy the top of the stack in the temporary given as argument, for a shared subexpression
+    LOAD_TEMP,     // push the temporary given as argument, for a shared subexpression evaluated before
+    CALL_UNARY,    // call a registered function with one argument
+    CALL_BINARY,   // call a registered function with two arguments
+    CALL_TERNARY,  // call a registered function with three arguments
+    FACTORIAL,     // postfix "!" operator
+    Count
+};
+
+// Structure representing a token (lexical unit)
+// the token is a view of the expression, so the tokenization does not allocate per token
+struct Token {
+    TokenType type = TokenType::NUMBER;
+    OpCode op      = OpCode::Count;  // operator code of an OPERATOR token, Count if the operator is unknown
+    double value   = 0.0;            // value of a NUMBER token
+    size_t offset  = 0U;             // offset of the token in the expression
+    size_t length  = 0U;             // count of characters of the token
+};
+
+// Definition of possible error codes
+enum class ErrorCode {
+    NONE = 0,
+    PARSE_ERROR,
+    EVALUATION_NAN,
+    EVALUATION_INF,
+    DIVISION_BY_ZERO,
+    UNKNOWN_NODE_TYPE,
+    EMPTY_PARENTHESIS,
+    VARIABLE_NOT_FOUND,
+    FUNCTION_NOT_FOUND,
+    OPERATOR_NOT_FOUND,
+    UNMATCHED_PARENTHESIS,
+    FUNCTION_WRONG_ARGUMENTS_COUNT,
+    Count
+};
+
+// Definition of possible node types in a syntax tree
+enum class NodeType {
+    NUMBER = 0,
+    VARIABLE,
+    OPERATOR,
+    FUNCTION,
+    Count
+};
+
+// Definition of the algebraic simplifications applied when lowering the syntax tree
+enum class SimplificationMode {
+    NONE = 0,  // no simplification
+    EXACT,     // only the rewrites keeping bit identical results (x*1, x/1, x-0, -(-x), x^1)
+    FAST,      // also the rewrites changing the rounding (x+0, x^n and pow(x, n) as multiplications, x^0.5 as sqrt)
+    Count
+};
+
+// Definition of the checks of the errors during the evaluation
+enum class ErrorCheckPolicy {
+    EVERY_NODE = 0,  // the value of each node is checked for NaN or Inf, the divisions for zero, reported at the first error
+    FINAL_RESULT,    // only the result is checked for NaN or Inf
+    STICKY_FLAGS,    // the errors of the nodes are accumulated in flags, reported once at the end of the evaluation or of the batch
+    NONE,            // no check, the result can be NaN or Inf
+    Count
+};
+
+// Structure representing a node in the syntax tree
+struct Node {
+    NodeType type = NodeType::NUMBER;
+    OpCode op     = OpCode::Count;  // operator code of an OPERATOR node
+    String name;
+    double value = 0.0;  // value of a NUMBER node, exponent of a POWI node
+    ::std::array<uint32_t, 3> childs{};  // Indexes of the child nodes in the nodes of the tree
+    size_t childCount = 0;
+};
+
+// Syntax tree, its nodes being stored contiguously and referencing their childs by index
+// the childs are added before their parent, an empty tree is the number 0
+struct SyntaxTree {
+    ::std::vector<Node> nodes = ::std::vector<Node>(1U);
+    uint32_t root             = 0U;
+
+    // Add a node and returns its index
+    uint32_t add(Node&& vNode) {
+        nodes.push_back(::std::move(vNode));
+        return static_cast<uint32_t>(nodes.size() - 1U);
+    }
+
+    Node& operator[](const uint32_t vIdx) {
+        return nodes[vIdx];
+    }
+
+    const Node& operator[](const uint32_t vIdx) const {
+        return nodes[vIdx];
+    }
+};
+
+// Structure representing an instruction of a compiled program
+struct Instruction {
+    OpCode op    = OpCode::PUSH_NUMBER;
+    uint32_t arg = 0U;  // index in the constants, variables or functions table depending of the op
+};
+
+// Structure representing a function called by a compiled program
+struct ProgramFunction {
+    String name;
+    size_t argCount          = 0U;
+    const Function* function = nullptr;  // entry resolved in the functions container
+    simd::UnaryKernel unaryKernel     = nullptr;  // kernel used by the batch evaluation, if any
+    simd::BinaryKernel binaryKernel   = nullptr;
+    simd::TernaryKernel ternaryKernel = nullptr;
+};
+
+// Flat postorder program lowered from the syntax tree
+struct Program {
+    ::std::vector<Instruction> code;
+    ::std::vector<double> constants;
+    ::std::vector<String> variables;
+    ::std::vector<ProgramFunction> functions;
+    size_t stackSize         = 0U;  // max count of values pushed at the same time
+    size_t tempsCount        = 0U;  // count of shared subexpressions values, stored after the stack
+    size_t functionsRevision = 0U;  // revision of the functions container used for resolving the functions
+    const simd::Kernels* kernels = nullptr;  // kernels used by the batch evaluation, the ones of the functions resolved with
+    ErrorCheckPolicy errorCheck  = ErrorCheckPolicy::EVERY_NODE;  // checks of the errors during the evaluation
+};
+
+// Pool of threads executing the tasks of a range, the calling thread taking part in the work
+// the tasks are pulled one by one by the threads, so the slow chunks doesn't block the others
+class ThreadPool {
+public:
+    // Task executed for the index vTask by the thread vWorker, in [0, getThreadsCount()), returns false if it failed
+    typedef ::std::function<bool(size_t vTask, size_t vWorker)> Task;
+
+    explicit ThreadPool(const size_t vThreadsCount) {
+        for (size_t worker = 1; worker < vThreadsCount; ++worker) {
+            m_Threads.emplace_back(&ThreadPool::m_work, this, worker);
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            ::std::lock_guard< ::std::mutex > lock(m_Mutex);
+            m_Stop = true;
+        }
+        m_StartCondition.notify_all();
+        for (auto& thread : m_Threads) {
+            thread.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Returns the count of threads executing the tasks, the calling thread included
+    size_t getThreadsCount() const {
+        return m_Threads.size() + 1U;
+    }
+
+    // Execute the tasks [0, vTasksCount) and wait for their end, returns the lowest failed task, vTasksCount if none
+    // the tasks after a failed one are skipped, and the exception thrown by the lowest task is rethrown
+    size_t run(const size_t vTasksCount, const Task& vTask) {
+        if (vTasksCount == 0U) {
+            return 0U;
+        }
+        {
+            ::std::lock_guard< ::std::mutex > lock(m_Mutex);
+            m_Task        = &vTask;
+            m_TasksCount  = vTasksCount;
+            m_NextTask    = 0U;
+            m_ErrorTask   = vTasksCount;
+            m_Error       = nullptr;
+            m_Pending     = m_Threads.size();
+            ++m_Generation;
+        }
+        m_StartCondition.notify_all();
+        m_execute(0U);
+        ::std::unique_lock< ::std::mutex > lock(m_Mutex);
+        m_DoneCondition.wait(lock, [this]() { return m_Pending == 0U; });
+        m_Task = nullptr;
+#ifdef USE_EXCEPTIONS
+        if (m_Error != nullptr) {
+            ::std::rethrow_exception(m_Error);
+        }
+#endif  // USE_EXCEPTIONS
+        return m_ErrorTask.load();
+    }
+
+private:
+    ::std::vector< ::std::thread > m_Threads;       // Workers, the calling thread being the worker 0
+    ::std::mutex m_Mutex;                           // Protects the state of the current run
+    ::std::condition_variable m_StartCondition;     // Signaled when a run starts or when the pool is destroyed
+    ::std::condition_variable m_DoneCondition;      // Signaled when the last worker ends a run
+    const Task* m_Task = nullptr;                   // Task of the current run
+    size_t m_TasksCount = 0U;                       // Count of tasks of the current run
+    ::std::atomic<size_t> m_NextTask{0U};           // Next task to execute
+    ::std::atomic<size_t> m_ErrorTask{0U};          // Lowest failed task, m_TasksCount if none
+    ::std::exception_ptr m_Error;                   // Exception thrown by m_ErrorTask, nullptr if it returned false
+    size_t m_Pending    = 0U;                       // Count of workers not done with the current run
+    size_t m_Generation = 0U;                       // Incremented at each run
+    bool m_Stop         = false;                    // The workers must exit
+
+    // Execute the tasks not taken by the other workers
+    void m_execute(const size_t vWorker) {
+        for (;;) {
+            const size_t task = m_NextTask.fetch_add(1U);
+            if (task >= m_TasksCount || task > m_ErrorTask.load()) {
+                break;
+            }
+#ifdef USE_EXCEPTIONS
+            try {
+                if (!(*m_Task)(task, vWorker)) {
+                    m_setError(task);
+                }
+            } catch (...) {
+                m_setError(task, ::std::current_exception());
+            }
+#else
+            if (!(*m_Task)(task, vWorker)) {
+                m_setError(task);
+            }
+#endif  // USE_EXCEPTIONS
+        }
+    }
+
+    // Keep the failure of a task if it is the lowest one, with the exception it has thrown if any
+    void m_setError(const size_t vTask, ::std::exception_ptr vError = nullptr) {
+        ::std::lock_guard< ::std::mutex > lock(m_Mutex);
+        if (vTask < m_ErrorTask.load()) {
+            m_ErrorTask = vTask;
+            m_Error     = vError;
+        }
+    }
+
+    // Loop of a worker, waiting for the runs
+    void m_work(const size_t vWorker) {
+        size_t generation = 0U;
+        ::std::unique_lock< ::std::mutex > lock(m_Mutex);
+        for (;;) {
+            m_StartCondition.wait(lock, [this, generation]() { return m_Stop || m_Generation != generation; });
+            if (m_Stop) {
+                return;
+            }
+            generation = m_Generation;
+            lock.unlock();
+            m_execute(vWorker);
+            lock.lock();
+            if (--m_Pending == 0U) {
+                m_DoneCondition.notify_one();
+            }
+        }
+    }
+};
+
+// Constants and functions known by a parsing, the syntax tree and the program lowered from it depend on
+// sorted by name, so the order of the insertions doesn't matter, the functors are not part of it
+struct RegistrySnapshot {
+    struct Entry {
+        String name;
+        uint64_t value   = 0U;  // bits of the value of a constant, arguments count of a function
+        bool isFunction  = false;
+        bool isPure      = false;
+        BuiltinId builtin = BuiltinId::NONE;
+
+        bool operator==(const Entry& vOther) const {
+            return value == vOther.value && isFunction == vOther.isFunction && isPure == vOther.isPure && builtin == vOther.builtin && name == vOther.name;
+        }
+    };
+
+    ::std::vector<Entry> entries;
+    uint64_t fingerprint = 0U;  // hash of the entries
+
+    bool operator==(const RegistrySnapshot& vOther) const {
+        return fingerprint == vOther.fingerprint && entries == vOther.entries;
+    }
+};
+
+// Settings of the compilation changing the program lowered from a syntax tree
+struct CompileSettings {
+    bool constantFolding              = true;
+    SimplificationMode simplification = SimplificationMode::NONE;
+    bool commonSubexpressions         = true;
+    ErrorCheckPolicy errorCheck       = ErrorCheckPolicy::EVERY_NODE;
+
+    bool operator==(const CompileSettings& vOther) const {
+        return constantFolding == vOther.constantFolding && simplification == vOther.simplification &&
+            commonSubexpressions == vOther.commonSubexpressions && errorCheck == vOther.errorCheck;
+    }
+};
+
+// Expression kept by the parse cache, with its syntax tree and the program lowered from it
+struct ParseCacheEntry {
+    String expr;
+    ::std::shared_ptr<const RegistrySnapshot> registry;  // constants and functions known by the parsing
+    ::std::shared_ptr<const SyntaxTree> tree;
+    CompileSettings settings;                            // settings of the compilation of the program
+    ::std::shared_ptr<const Program> program;            // nullptr if not shareable, its functions being resolved by each expression
+};
+
+// Process-wide cache of the syntax trees and of their programs, used by the expressions parsed with Expr::setParseCaching(true)
+// the key is the expression and the constants and functions known by the parsing, compared in full on a hit
+// the entries are immutable and shared, the least recently used one is removed when the capacity is reached
+class ParseCache {
+public:
+    // Returns the cache of the process
+    static ParseCache& get() {
+        static ParseCache s_Cache;
+        return s_Cache;
+    }
+
+    // Set the max count of entries kept, 1024 by default
+    void setCapacity(const size_t vCapacity) {
+        ::std::lock_guard< ::std::mutex > lock(m_Mutex);
+        m_Capacity = vCapacity;
+        m_evict();
+    }
+
+    // Returns the max count of entries kept
+    size_t getCapacity() const {
+        ::std::lock_guard< ::std::mutex > lock(m_Mutex);
+        return m_Capacity;
+    }
+
+    // Returns the count of entries kept
+    size_t getSize() const {
+        ::std::lock_guard< ::std::mutex > lock(m_Mutex);
+        return m_Entries.size();
+    }
+
+    // Returns the count of parsings which found their tree in the cache
+    size_t getHitsCount() const {
+        ::std::lock_guard< ::std::mutex > lock(m_Mutex);
+        return m_HitsCount;
+    }
+
+    // Returns the count of parsings which did not find their tree in the cache
+    size_t getMissesCount() const {
+        ::std::lock_guard< ::std::mutex > lock(m_Mutex);
+        return m_MissesCount;
+    }
+
+    // Remove the entries and reset the counters
+    void clear() {
+        ::std::lock_guard< ::std::mutex > lock(m_Mutex);
+        m_Entries.clear();
+        m_Index.clear();
+        m_HitsCount   = 0U;
+        m_MissesCount = 0U;
+    }
+
+    // Returns the entry of an expression parsed with some constants and functions, nullptr if not cached
+    ::std::shared_ptr<const ParseCacheEntry> find(const String& vExpr, const ::std::shared_ptr<const RegistrySnapshot>& vRegistry) {
+        ::std::lock_guard< ::std::mutex > lock(m_Mutex);
+        auto it = m_find(vExpr, *vRegistry);
+        if (it == m_Entries.end()) {
+            ++m_MissesCount;
+            return nullptr;
+        }
+        ++m_HitsCount;
+        m_Entries.splice(m_Entries.begin(), m_Entries, it);  // the most recently used first
+        return *it;
+    }
+
+    // Add an entry, replacing the one of the same expression and registry
+    void insert(const ::std::shared_ptr<const ParseCacheEntry>& vEntry) {
+        ::std::lock_guard< ::std::mutex > lock(m_Mutex);
+        auto it = m_find(vEntry->expr, *vEntry->registry);
+        if (it != m_Entries.end()) {
+            *it = vEntry;
+            m_Entries.splice(m_Entries.begin(), m_Entries, it);
+            return;
+        }
+        m_Entries.push_front(vEntry);
+        m_Index.emplace(m_getHash(vEntry->expr, *vEntry->registry), m_Entries.begin());
+        m_evict();
+    }
+
+private:
+    typedef ::std::list< ::std::shared_ptr<const ParseCacheEntry> > Entries;
+
+    mutable ::std::mutex m_Mutex;
+    Entries m_Entries;                                            // Entries, the most recently used first
+    ::std::unordered_multimap<uint64_t, Entries::iterator> m_Index;  // Entries of each hash, compared in full
+    size_t m_Capacity    = 1024U;
+    size_t m_HitsCount   = 0U;
+    size_t m_MissesCount = 0U;
+
+    ParseCache() = default;
+
+    static uint64_t m_getHash(const String& vExpr, const RegistrySnapshot& vRegistry) {
+        return vRegistry.fingerprint ^ (static_cast<uint64_t>(vExpr.getHash()) * 0x9E3779B97F4A7C15ULL);
+    }
+
+    // Returns the entry of an expression and a registry, m_Entries.end() if none
+    // the registries of the expressions sharing their entries are shared too, so they are mostly compared by address
+    Entries::iterator m_find(const String& vExpr, const RegistrySnapshot& vRegistry) {
+        auto range = m_Index.equal_range(m_getHash(vExpr, vRegistry));
+        for (auto it = range.first; it != range.second; ++it) {
+            const ParseCacheEntry& entry = **it->second;
+            if (entry.expr == vExpr && (entry.registry.get() == &vRegistry || *entry.registry == vRegistry)) {
+                return it->second;
+            }
+        }
+        return m_Entries.end();
+    }
+
+    // Remove the least recently used entries above the capacity
+    void m_evict() {
+        while (m_Entries.size() > m_Capacity) {
+            auto last  = ::std::prev(m_Entries.end());
+            auto range = m_Index.equal_range(m_getHash((*last)->expr, *(*last)->registry));
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second == last) {
+                    m_Index.erase(it);
+                    break;
+                }
+            }
+            m_Entries.pop_back();
+        }
+    }
+};
+
+// Error returned by the functions not throwing, like Expr::tryParse or Expr::tryEval
+struct ExprError {
+    ErrorCode code = ErrorCode::NONE;  // ErrorCode::NONE if no error
+    String message;                    // Message of the error, the one of the ExprException thrown by the throwing functions
+};
+
+// Class to manage exceptions specific to expression evaluation
+class ExprException : public ::std::exception {
+public:
+    ExprException(ErrorCode code, const String& message)
+        : m_Code(code), m_Message(message) {
+    }
+
+    ErrorCode getCode() const {
+        return m_Code;
+    }
+
+    const char* what() const noexcept override {
+        return m_Message.c_str();  // Return the error message
+    }
+
+private:
+    ErrorCode m_Code;
+    String m_Message;
+};
+
+// Native x86-64 code of a program, compiled when Expr::setJitCompilation is enabled (Linux x86-64 only)
+// the values of the stack are kept in the xmm registers, the functions are called through their registered functors
+// on an error the native code stops, and the program is evaluated again by the interpreter which reports the error
+class JitProgram {
+public:
+    JitProgram(const JitProgram&)            = delete;  // owns its executable memory
+    JitProgram& operator=(const JitProgram&) = delete;
+
+    ~JitProgram() {
+#ifdef USE_JIT
+        munmap(m_Memory, m_Size);
+#endif  // USE_JIT
+    }
+
+    // Compile a program in native code, nullptr if the platform or the program is not supported
+    // the functions called by the program must stay valid as long as the native code is used
+    static ::std::unique_ptr<JitProgram> create(const Program& vProgram);
+
+    // Execute the native code, the stack must be able to contain the stack and the temporaries of the program
+    // returns false if the native code stopped on an error, vResult being then not set
+    // the exceptions thrown by the functions called are thrown again here
+    bool run(const double* const* vSources, double* vStack, double& vResult) const {
+        CallError error;
+        const int ret = reinterpret_cast<Entry>(m_Memory)(vSources, vStack, &error);
+#ifdef USE_EXCEPTIONS
+        if (error.isFailed) {
+            ::std::rethrow_exception(error.exception);
+        }
+#endif  // USE_EXCEPTIONS
+        if (ret != 0) {
+            return false;
+        }
+        vResult = vStack[0];
+        return true;
+    }
+
+    // Returns the size of the native code in bytes
+    size_t getCodeSize() const {
+        return m_Size;
+    }
+
+private:
+    // Error of a function called by the native code, the native code stopping when isFailed is set
+    struct CallError {
+        bool isFailed = false;  // first member, tested by the native code
+        ::std::exception_ptr exception;
+    };
+
+    // Signature of the native code, returns 0 on success, the result being stored in vStack[0]
+    typedef int (*Entry)(const double* const* vSources, double* vStack, CallError* vError);
+    typedef ::std::vector<uint8_t> Bytes;
+
+    static constexpr uint32_t s_RegistersCount = 14U;  // xmm0 to xmm13 contain the stack, xmm14 and xmm15 are scratch
+    static constexpr uint32_t s_ZeroRegister   = 14U;
+    static constexpr uint32_t s_ScratchRegister = 15U;
+
+    // Conditions of the jumps to the error exit
+    static constexpr uint8_t s_JumpIfEqual  = 0x84U;  // also taken for NaN after ucomisd
+    static constexpr uint8_t s_JumpIfNotEqual = 0x85U;
+    static constexpr uint8_t s_JumpIfBelow  = 0x82U;  // also taken for NaN after ucomisd
+    static constexpr uint8_t s_JumpIfParity = 0x8AU;  // taken for NaN after ucomisd
+
+    void* m_Memory = nullptr;  // executable memory of the native code
+    size_t m_Size  = 0U;       // size of the native code
+
+    JitProgram() = default;
+
+    // Call a function catching its exceptions, they can't go through the native code
+    template <typename tCall>
+    static double m_call(CallError* vError, const tCall& vCall) {
+#ifdef USE_EXCEPTIONS
+        try {
+            return vCall();
+        } catch (...) {
+            vError->isFailed  = true;
+            vError->exception = ::std::current_exception();
+            return 0.0;
+        }
+#else
+        (void)vError;
+        return vCall();
+#endif  // USE_EXCEPTIONS
+    }
+
+    // Functions called by the native code
+    static double m_callUnary(const Function* vFunction, CallError* vError, double vA) {
+        return m_call(vError, [&] { return vFunction->unaryFunctor(vA); });
+    }
+    static double m_callBinary(const Function* vFunction, CallError* vError, double vA, double vB) {
+        return m_call(vError, [&] { return vFunction->binaryFunctor(vA, vB); });
+    }
+    static double m_callTernary(const Function* vFunction, CallError* vError, double vA, double vB, double vC) {
+        return m_call(vError, [&] { return vFunction->ternaryFunctor(vA, vB, vC); });
+    }
+    static double m_callPow(double vX, double vY) {
+        return ::std::pow(vX, vY);
+    }
+    static double m_callMod(double vX, double vY) {
+        return ::std::fmod(vX, vY);
+    }
+
+    // Emit bytes of code
+    static void m_emit(Bytes& vCode, ::std::initializer_list<uint8_t> vBytes) {
+        vCode.insert(vCode.end(), vBytes);
+    }
+
+    // Emit a little endian value of vCount bytes
+    static void m_emitValue(Bytes& vCode, uint64_t vValue, size_t vCount) {
+        for (size_t idx = 0; idx < vCount; ++idx) {
+            vCode.push_back(static_cast<uint8_t>(vValue >> (8U * idx)));
+        }
+    }
+
+    // Emit a sse2 instruction between two xmm registers : prefix, rex, 0x0F, opcode, modrm
+    static void m_emitXmm(Bytes& vCode, uint8_t vPrefix, uint8_t vOpCode, uint32_t vDst, uint32_t vSrc) {
+        vCode.push_back(vPrefix);
+        if (vDst >= 8U || vSrc >= 8U) {
+            vCode.push_back(static_cast<uint8_t>(0x40U | (vDst >= 8U ? 4U : 0U) | (vSrc >= 8U ? 1U : 0U)));
+        }
+        m_emit(vCode, {0x0FU, vOpCode, static_cast<uint8_t>(0xC0U | ((vDst & 7U) << 3U) | (vSrc & 7U))});
+    }
+
+    // Emit a copy between two xmm registers, nothing if they are the same
+    static void m_emitMove(Bytes& vCode, uint32_t vDst, uint32_t vSrc) {
+        if (vDst != vSrc) {
+            m_emitXmm(vCode, 0x66U, 0x28U, vDst, vSrc);  // movapd
+        }
+    }
+
+    // Emit a movsd between an xmm register and a slot of the stack memory (rbp), 0x10 for a load, 0x11 for a store
+    static void m_emitStackSlot(Bytes& vCode, uint8_t vOpCode, uint32_t vReg, size_t vSlot) {
+        vCode.push_back(0xF2U);
+        if (vReg >= 8U) {
+            vCode.push_back(0x44U);
+        }
+        m_emit(vCode, {0x0FU, vOpCode, static_cast<uint8_t>(0x85U | ((vReg & 7U) << 3U))});  // [rbp + disp32]
+        m_emitValue(vCode, vSlot * sizeof(double), 4U);
+    }
+
+    // Emit the load of the bits of a double in an xmm register, through rax
+    static void m_emitConstant(Bytes& vCode, uint32_t vReg, uint64_t vBits) {
+        m_emit(vCode, {0x48U, 0xB8U});  // mov rax, imm64
+        m_emitValue(vCode, vBits, 8U);
+        m_emit(vCode, {0x66U, static_cast<uint8_t>(vReg >= 8U ? 0x4CU : 0x48U), 0x0FU, 0x6EU, static_cast<uint8_t>(0xC0U | ((vReg & 7U) << 3U))});  // movq xmm, rax
+    }
+
+    // Emit a conditional jump to the error exit, its offset being patched at the end
+    static void m_emitJump(Bytes& vCode, uint8_t vCondition, ::std::vector<size_t>& vJumps) {
+        m_emit(vCode, {0x0FU, vCondition});
+        vJumps.push_back(vCode.size());
+        m_emitValue(vCode, 0U, 4U);
+    }
+
+    // Emit a jump to the error exit if a register compared to zero meets a condition
+    static void m_emitCheckZero(Bytes& vCode, uint32_t vReg, uint8_t vCondition, ::std::vector<size_t>& vJumps) {
+        m_emitXmm(vCode, 0x66U, 0x57U, s_ZeroRegister, s_ZeroRegister);  // xorpd, the calls don't keep the registers
+        m_emitXmm(vCode, 0x66U, 0x2EU, vReg, s_ZeroRegister);             // ucomisd
+        m_emitJump(vCode, vCondition, vJumps);
+    }
+
+    // Emit a jump to the error exit if a register is NaN or Inf, x - x being NaN for them
+    static void m_emitCheckFinite(Bytes& vCode, uint32_t vReg, ::std::vector<size_t>& vJumps) {
+        m_emitMove(vCode, s_ScratchRegister, vReg);
+        m_emitXmm(vCode, 0xF2U, 0x5CU, s_ScratchRegister, s_ScratchRegister);  // subsd
+        m_emitXmm(vCode, 0x66U, 0x2EU, s_ScratchRegister, s_ScratchRegister);  // ucomisd
+        m_emitJump(vCode, s_JumpIfParity, vJumps);
+    }
+
+    // Emit the call of a function taking the vArgCount values of the top of the stack, its result replacing them
+    // the registers below the arguments are saved in the stack memory during the call, rdi and rsi must be already set
+    static void m_emitCall(Bytes& vCode, uint32_t vDepth, uint32_t vArgCount, uint64_t vAddress) {
+        const uint32_t base = vDepth - vArgCount;
+        for (uint32_t reg = 0U; reg < base; ++reg) {
+            m_emitStackSlot(vCode, 0x11U, reg, reg);
+        }
+        for (uint32_t arg = 0U; arg < vArgCount; ++arg) {
+            m_emitMove(vCode, arg, base + arg);  // base + arg >= arg, so no argument is overwritten before being moved
+        }
+        m_emit(vCode, {0x48U, 0xB8U});  // mov rax, imm64
+        m_emitValue(vCode, vAddress, 8U);
+        m_emit(vCode, {0xFFU, 0xD0U});  // call rax
+        m_emitMove(vCode, base, 0U);
+        for (uint32_t reg = 0U; reg < base; ++reg) {
+            m_emitStackSlot(vCode, 0x10U, reg, reg);
+        }
+    }
+
+    // Emit the restore of the registers saved by the prologue and the return
+    static void m_emitEpilogue(Bytes& vCode) {
+        m_emit(vCode, {0x41U, 0x5CU, 0x5DU, 0x5BU, 0xC3U});  // pop r12, pop rbp, pop rbx, ret
+    }
+
+    // Emit the code of a registered function, the builtins having an exact sse2 instruction being inlined
+    static void m_emitFunction(Bytes& vCode, const ProgramFunction& vFunction, uint32_t vDepth, ::std::vector<size_t>& vJumps);
+};
+
+class CompiledExpr;
+
+#ifdef USE_CONSTEXPR_PARSING
+namespace ct {
+struct Builtins;
+}  // namespace ct
+#endif  // USE_CONSTEXPR_PARSING
+
+// Main class for evaluating mathematical expressions
+class Expr {
+    friend class CompiledExpr;
+    friend class EvalContext;
+    friend class JitProgram;
+#ifdef USE_CONSTEXPR_PARSING
+    friend struct ct::Builtins;
+#endif  // USE_CONSTEXPR_PARSING
+
+private:
+    static constexpr double s_MaxIntegerPower = 8.0;  // max exponent replaced by a chain of multiplications
+    static constexpr size_t s_MaxNumberDigits = 800U;  // significant digits of a number literal kept, 768 are enough for the rounding
+    static constexpr size_t s_BatchBlockSize  = 256U;  // count of rows evaluated together by evalBatch
+    static constexpr size_t s_BatchChunkSize  = 16U * s_BatchBlockSize;  // count of rows of a task of a parallel evalBatch
+
+    // Errors accumulated with the ErrorCheckPolicy::STICKY_FLAGS policy
+    static constexpr uint32_t s_DivisionByZeroFlag = 1U << 0U;
+    static constexpr uint32_t s_NegativePowFlag    = 1U << 1U;
+    static constexpr uint32_t s_NanFlag            = 1U << 2U;
+    static constexpr uint32_t s_InfFlag            = 1U << 3U;
+
+    // Structural key of a node whose childs are already shared, identical for structurally identical subtrees
+    struct NodeKey {
+        NodeType type       = NodeType::Count;  // Count for an empty entry of the shared nodes
+        OpCode op           = OpCode::Count;
+        uint32_t childCount = 0U;
+        ::std::array<uint32_t, 3> childs{};   // the childs are shared, so they are identified by their index
+        uint64_t bits      = 0U;              // bits of the value, 0 and -0 being not the same
+        const String* name = nullptr;         // name of a variable or of a function, in the tree being compiled
+
+        bool operator==(const NodeKey& vOther) const {
+            return type == vOther.type && op == vOther.op && childCount == vOther.childCount && childs == vOther.childs && bits == vOther.bits &&
+                (name == vOther.name || (name != nullptr && vOther.name != nullptr && *name == *vOther.name));
+        }
+    };
+
+    // Entry of the open addressing table of the structurally identical subtrees met during the common subexpressions elimination
+    struct SharedNode {
+        NodeKey key;
+        uint32_t node = 0U;
+    };
+
+    // State of the lowering of a DAG, indexed like the nodes of the tree
+    struct EmitState {
+        ::std::vector<uint32_t> refsCount;  // count of parents of each node
+        ::std::vector<uint32_t> temps;      // temporary + 1 of the shared nodes already emitted, 0 if not emitted
+    };
+
+    String m_Expr;                                            // Expression to evaluate
+    ::std::vector<Token> m_Tokens;                            // Tokens of the last parsing, kept to reuse their memory
+    ::std::shared_ptr<const SyntaxTree> m_Tree = ::std::make_shared<SyntaxTree>();  // Syntax tree of the expression, immutable
+    Program m_Program;                                        // Program lowered from the syntax tree
+    ::std::vector<double> m_Stack;                            // Values stack used during the evaluation
+    ::std::vector< ::std::vector<double> > m_BatchStacks;    // Stack of blocks of values of each thread of a batch evaluation
+    ::std::vector< ::std::pair<size_t, ExprError> > m_BatchErrors;  // Failed task and its error of each thread of a batch evaluation
+    ::std::vector<const double*> m_BatchColumns;              // Column of the values of each slot in a batch, nullptr if none
+    const simd::Kernels* m_Kernels = &simd::getKernels(simd::getBestInstructionSet());  // Kernels of the batch evaluation
+    ::std::unique_ptr<ThreadPool> m_ThreadPool;               // Threads of the batch evaluation, nullptr if single threaded
+    VarContainer m_ParsedVariables;                           // Container for variables found during parsing
+    VarContainer m_DefinedVariables;                          // Container for variables defined after parsing
+    FlatMap<VarHandle> m_VarSlots;                            // Slot of each variable found during parsing
+    ::std::vector<double> m_VarValues;                        // Values of the variables, indexed by slot
+    ::std::vector<const double*> m_VarSources;                // Address read for each slot, nullptr if not defined
+    ::std::unordered_map<String, VarBinding> m_VarBindings;   // Variables bound to a memory owned by the caller
+    ::std::vector< ::std::pair<uint32_t, size_t> > m_OffsetSlots;  // Slots bound to an offset from the binding base
+    const char* m_BindingBase = nullptr;                      // Base address of the variables bound with an offset
+    bool m_DefinedVarsDirty = false;                          // Defined variables modified from outside
+    ConstantContainer m_Constant;                             // Container for constants
+    FunctionContainer m_Functions;                            // Container for functions
+    size_t m_FunctionsRevision = 0U;                          // Incremented each time a function is added or replaced
+    ::std::shared_ptr<const RegistrySnapshot> m_Registry;     // Constants and functions compared by the parse cache
+    bool m_RegistryDirty = true;                              // Constants or functions modified since the snapshot
+    bool m_ParseCaching = false;                              // The syntax trees are shared through the parse cache
+    double m_EvalResult = 0.0;                                // Evaluation result
+    ExprError m_Error;                                        // Error of the last parsing or evaluation
+    bool m_Verbose      = false;                              // Verbose mode
+    bool m_ConstantFolding = true;                            // Constant subtrees are replaced by their value
+    SimplificationMode m_Simplification = SimplificationMode::NONE;  // Algebraic simplifications applied
+    ErrorCheckPolicy m_ErrorCheck = ErrorCheckPolicy::EVERY_NODE;  // Checks of the errors during the evaluation
+    bool m_CommonSubexpressions = true;                       // Identical subtrees are evaluated once
+    ::std::vector<SharedNode> m_SharedNodes;                  // Table of the common subexpressions elimination, reused by each compilation
+    EmitState m_EmitState;                                    // References and temporaries of the shared nodes, reused by each compilation
+    bool m_JitCompilation = false;                            // The program is compiled in native code
+    ::std::unique_ptr<JitProgram> m_Jit;                      // Native code of the program, nullptr if not compiled
+    ::std::stringstream m_printExpr;                          // Stream to print the expression and result
+    ::std::chrono::duration<double, ::std::milli> m_Elapsed;  // Evaluation time
+    ::std::chrono::steady_clock::time_point m_StartTime;
+    ::std::chrono::steady_clock::time_point m_EndTime;
+
+public:
+    Expr() {
+#ifdef DEFINE_DEFAULT_BUILTINS
+        defineDefaultBuiltins();
+#endif  // DEFINE_DEFAULT_BUILTINS
+        m_compile();  // an expression not parsed evaluates to 0.0
+    }
+
+    void defineDefaultBuiltins() {
+        // Initialization of common constants
+        addConstant("pi", M_PI);  // PI
+        addConstant("e", M_E);    // e
+
+        // Initialization of common unary functions, all the builtins are pure functions
+        m_addBuiltin(BuiltinId::ABS, "abs", [](double a) { return ::std::abs(a); });
+        m_addBuiltin(BuiltinId::FLOOR, "floor", [](double a) { return ::std::floor(a); });
+        m_addBuiltin(BuiltinId::CEIL, "ceil", [](double a) { return ::std::ceil(a); });
+        m_addBuiltin(BuiltinId::ROUND, "round", [](double a) { return ::std::round(a); });
+
+        m_addBuiltin(BuiltinId::FRACT, "fract", [](double a) { return a - ::std::floor(a); });
+        m_addBuiltin(BuiltinId::SIGN, "sign", [](double a) { return m_Sign(a); });
+
+        m_addBuiltin(BuiltinId::SIN, "sin", [](double a) { return ::std::sin(a); });
+        m_addBuiltin(BuiltinId::COS, "cos", [](double a) { return ::std::cos(a); });
+        m_addBuiltin(BuiltinId::TAN, "tan", [](double a) { return ::std::tan(a); });
+
+        m_addBuiltin(BuiltinId::ASIN, "asin", [](double a) { return ::std::asin(a); });
+        m_addBuiltin(BuiltinId::ACOS, "acos", [](double a) { return ::std::acos(a); });
+        m_addBuiltin(BuiltinId::ATAN, "atan", [](double a) { return ::std::atan(a); });
+
+        m_addBuiltin(BuiltinId::SINH, "sinh", [](double a) { return ::std::sinh(a); });
+        m_addBuiltin(BuiltinId::COSH, "cosh", [](double a) { return ::std::cosh(a); });
+        m_addBuiltin(BuiltinId::TANH, "tanh", [](double a) { return ::std::tanh(a); });
+
+        m_addBuiltin(BuiltinId::ASINH, "asinh", [](double a) { return ::std::asinh(a); });
+        m_addBuiltin(BuiltinId::ACOSH, "acosh", [](double a) { return ::std::acosh(a); });
+        m_addBuiltin(BuiltinId::ATANH, "atanh", [](double a) { return ::std::atanh(a); });
+
+        m_addBuiltin(BuiltinId::LN, "ln", [](double a) { return ::std::log(a); });
+        m_addBuiltin(BuiltinId::LOG, "log", [](double a) { return ::std::log(a); });
+        m_addBuiltin(BuiltinId::LOG1P, "log1p", [](double a) { return ::std::log1p(a); });
+        m_addBuiltin(BuiltinId::LOGB, "logb", [](double a) { return ::std::logb(a); });
+        m_addBuiltin(BuiltinId::LOG2, "log2", [](double a) { return ::std::log2(a); });
+        m_addBuiltin(BuiltinId::LOG10, "log10", [](double a) { return ::std::log10(a); });
+
+        m_addBuiltin(BuiltinId::SQRT, "sqrt", [](double a) { return ::std::sqrt(a); });
+        m_addBuiltin(BuiltinId::EXP, "exp", [](double a) { return ::std::exp(a); });
+
+        m_addBuiltin(BuiltinId::FACT, "fact", [](double a) { return m_Factorial(a); });
+
+        m_addBuiltin(BuiltinId::SATURATE, "saturate", [](double a) { return m_Clamp(a, 0.0, 1.0); });
+
+        // Initialization of common binary functions
+        m_addBuiltin(BuiltinId::MOD, "mod", [](double a, double b) { return ::std::fmod(a, b); });
+        m_addBuiltin(BuiltinId::POW, "pow", [](double a, double b) { return a < 0.0 ? ::std::numeric_limits<double>::quiet_NaN() : ::std::pow(a, b); });
+        m_addBuiltin(BuiltinId::ATAN2, "atan2", [](double a, double b) { return ::std::atan2(a, b); });
+        m_addBuiltin(BuiltinId::MIN, "min", [](double a, double b) { return m_Min(a, b); });
+        m_addBuiltin(BuiltinId::MAX, "max", [](double a, double b) { return m_Max(a, b); });
+        m_addBuiltin(BuiltinId::STEP, "step", [](double a, double b) { return m_Step(a, b); });
+        m_addBuiltin(BuiltinId::HYPOT, "hypot", [](double a, double b) { return ::std::hypot(a, b); });
+        m_addBuiltin(BuiltinId::SMOOTHABS, "smoothabs", [](double a, double b) { return m_SmoothAbs(a, b); });
+
+        // Initialization of common ternary functions
+        m_addBuiltin(BuiltinId::CLAMP, "clamp", [](double a, double b, double c) { return m_Clamp(a, b, c); });
+        m_addBuiltin(BuiltinId::LERP, "lerp", [](double a, double b, double c) { return m_Mix(a, b, c); });
+        m_addBuiltin(BuiltinId::MIX, "mix", [](double a, double b, double c) { return m_Mix(a, b, c); });
+        m_addBuiltin(BuiltinId::SMOOTHSTEP, "smoothstep", [](double a, double b, double c) { return m_SmoothStep(a, b, c); });
+    }
+
+    // Method to parse an expression
+    Expr& parse(const String& vExpr) {
+        tryParse(vExpr);
+        m_throwError(m_Error.code, m_Error.message);
+        return *this;
+    }
+
+    // Method to parse an expression without throwing, returns the error code, its message being given by getError()
+    // an expression not parsed evaluates to 0.0
+    ErrorCode tryParse(const String& vExpr) {
+        m_clearError();
+        m_Expr = vExpr;                            // Store the expression
+        m_syncDefinedVars();                       // keep the values of the current variables for the next ones
+        m_ParsedVariables.clear();                 // clearing discoverd vairable during parsing
+        ErrorCode code = ErrorCode::NONE;
+        ::std::shared_ptr<const ParseCacheEntry> cached;
+        m_Tree = nullptr;
+        if (m_ParseCaching) {
+            cached = ParseCache::get().find(m_Expr, m_getRegistry());
+            if (cached != nullptr) {
+                m_Registry = cached->registry;  // equal to ours, shared so the next lookups compare it by address
+                m_Tree     = cached->tree;
+            }
+        }
+        if (m_Tree == nullptr) {
+            auto tree = ::std::make_shared<SyntaxTree>();
+            code      = m_parseTree(*tree);  // Tokenize the expression and create the syntax tree
+            if (code != ErrorCode::NONE) {
+                *tree = SyntaxTree();
+            }
+            m_Tree = tree;
+        }
+
+        m_VarSlots.clear();
+        if (cached != nullptr && cached->program != nullptr && cached->settings == m_getCompileSettings()) {
+            m_Program = *cached->program;  // only its functions are resolved again, for the functors of this expression
+            for (size_t slot = 0; slot < m_Program.variables.size(); ++slot) {
+                VarHandle handle;
+                handle.slot = static_cast<uint32_t>(slot);
+                m_VarSlots.emplace(m_Program.variables[slot], handle);
+                m_ParsedVariables[m_Program.variables[slot]] = 0.0;
+            }
+            code = m_linkProgram(ErrorCode::NONE);
+        } else {
+            m_Program.variables.clear();
+            m_assignVarSlots(m_Tree->root);
+            const ErrorCode compileCode = m_compile();  // Lower the syntax tree into a flat program
+            if (code == ErrorCode::NONE) {
+                code = compileCode;
+            }
+            if (m_ParseCaching && code == ErrorCode::NONE) {  // the errors are not cached
+                auto entry      = ::std::make_shared<ParseCacheEntry>();
+                entry->expr     = m_Expr;
+                entry->registry = m_Registry;
+                entry->tree     = m_Tree;
+                entry->settings = m_getCompileSettings();
+                if (m_isProgramShareable()) {
+                    auto program = ::std::make_shared<Program>(m_Program);
+                    for (auto& fun : program->functions) {
+                        fun.function = nullptr;  // entry of the functions container of this expression
+                    }
+                    entry->program = program;
+                }
+                ParseCache::get().insert(entry);
+            }
+        }
+        m_loadDefinedVars();
+        return code;
+    }
+
+    // Method to enable or disable the parse cache, disabled by default
+    // the expressions parsed with the same text, constants and functions share their syntax tree, and their program if
+    // parsed with the same compilation settings and folding no user pure function, only the functors being resolved again
+    Expr& setParseCaching(bool vEnabled) {
+        m_ParseCaching = vEnabled;
+        return *this;
+    }
+
+    // Method to set the value of a variable
+    Expr& set(const String& vName, const double vValue, const bool vIfNotExist = false) {
+        auto it = m_VarSlots.find(vName);
+        if (it != m_VarSlots.end()) {
+            if (m_DefinedVarsDirty) {
+                m_loadDefinedVars();
+            }
+            if (!vIfNotExist || m_VarSources[it->second.slot] == nullptr) {
+                m_VarValues[it->second.slot]  = vValue;
+                m_VarSources[it->second.slot] = &m_VarValues[it->second.slot];
+            }
+            return *this;
+        }
+        if (vIfNotExist) {
+            if (m_DefinedVariables.find(vName) != m_DefinedVariables.end() ||  // If exists
+                m_VarBindings.find(vName) != m_VarBindings.end()) {
+                return *this;
+            }
+        }
+        m_DefinedVariables[vName] = vValue;
+        m_VarBindings.erase(vName);  // a set variable is not bound anymore
+        return *this;
+    }
+
+    // Returns the handle of a variable found during parsing
+    VarHandle getVarHandle(const String& vName) const {
+        auto it = m_VarSlots.find(vName);
+        if (it == m_VarSlots.end()) {
+            m_throwError(ErrorCode::VARIABLE_NOT_FOUND, "Variable not found: " + vName);
+        }
+        return it->second;
+    }
+
+    // Method to set the value of a variable from its handle, without name lookup
+    Expr& set(const VarHandle vHandle, const double vValue) {
+        if (m_DefinedVarsDirty) {
+            m_loadDefinedVars();
+        }
+        m_VarValues[vHandle.slot]  = vValue;
+        m_VarSources[vHandle.slot] = &m_VarValues[vHandle.slot];  // a set variable is not bound anymore
+        return *this;
+    }
+
+    // Method to bind a variable to a memory owned by the caller, read at each evaluation
+    // the binding is kept from a parsing to another, until the variable is set or unbound
+    Expr& bindVariable(const String& vName, const double* vPtr) {
+        if (vPtr == nullptr) {
+            return unbindVariable(vName);
+        }
+        VarBinding binding;
+        binding.ptr = vPtr;
+        return m_bindVariable(vName, binding);
+    }
+
+    // Method to bind a variable to an offset from the address given by setBindingBase
+    // ex: bindVariableOffset("x", offsetof(State, x)).setBindingBase(&state)
+    Expr& bindVariableOffset(const String& vName, const size_t vOffset) {
+        VarBinding binding;
+        binding.offset   = vOffset;
+        binding.isOffset = true;
+        return m_bindVariable(vName, binding);
+    }
+
+    // Method to set the base address of the variables bound with an offset
+    Expr& setBindingBase(const void* vBase) {
+        m_BindingBase = static_cast<const char*>(vBase);
+        for (const auto& it : m_OffsetSlots) {
+            m_VarSources[it.first] = m_getOffsetSource(it.second);
+        }
+        return *this;
+    }
+
+    // Method to unbind a variable, it get back its defined value if any
+    Expr& unbindVariable(const String& vName) {
+        m_syncDefinedVars();
+        m_VarBindings.erase(vName);
+        m_loadDefinedVars();
+        return *this;
+    }
+
+    // Method to evaluate the expression
+    Expr& eval() {
+        double result = 0.0;
+        tryEval(result);
+        m_throwError(m_Error.code, m_Error.message);
+        return *this;
+    }
+
+    // Method to evaluate the expression without throwing, returns the error code, its message being given by getError()
+    // vResult and getResult() are set only if the evaluation succeeded
+    ErrorCode tryEval(double& vResult) {
+        m_clearError();
+        if (m_DefinedVarsDirty) {
+            m_loadDefinedVars();
+        }
+        if (m_Program.functionsRevision != m_FunctionsRevision && m_compile() != ErrorCode::NONE) {
+            return m_Error.code;  // the functions called or folded by the program may have changed
+        }
+        const bool isJitDone = (m_Jit != nullptr && !m_Verbose && m_Jit->run(m_VarSources.data(), m_Stack.data(), m_EvalResult));
+        if (!isJitDone && m_run(m_Program, m_VarSources.data(), m_Stack.data(), m_EvalResult, m_Error, m_Verbose) != ErrorCode::NONE) {  // Execute the program lowered from the syntax tree
+            return m_Error.code;
+        }
+        vResult = m_EvalResult;
+        return ErrorCode::NONE;
+    }
+
+    // Method to evaluate the expression for vCount rows, the values of the variables being read in columns of vCount values
+    // the variables without column keep their single value, and the columns of unknown variables are ignored
+    // if vErrors is not nullptr, the error of each row is written in it (ErrorCode::NONE if none) and doesn't stop the evaluation
+    Expr& evalBatch(const size_t vCount, const ::std::unordered_map<String, const double*>& vColumns, double* vOut, ErrorCode* vErrors = nullptr) {
+        tryEvalBatch(vCount, vColumns, vOut, vErrors);
+        m_throwError(m_Error.code, m_Error.message);
+        return *this;
+    }
+
+    // Method to evaluate the expression for vCount rows, with the columns of the variables given by handle
+    Expr& evalBatch(const size_t vCount, const ::std::vector< ::std::pair<VarHandle, const double*> >& vColumns, double* vOut, ErrorCode* vErrors = nullptr) {
+        tryEvalBatch(vCount, vColumns, vOut, vErrors);
+        m_throwError(m_Error.code, m_Error.message);
+        return *this;
+    }
+
+    // Method to evaluate the expression for vCount rows without throwing, returns the error code, its message being given by getError()
+    // with vErrors, only the errors not related to a row are returned, like a variable not defined
+    ErrorCode tryEvalBatch(const size_t vCount, const ::std::unordered_map<String, const double*>& vColumns, double* vOut, ErrorCode* vErrors = nullptr) {
+        m_BatchColumns.assign(m_VarSources.size(), nullptr);
+        for (const auto& column : vColumns) {
+            auto it = m_VarSlots.find(column.first);
+            if (it != m_VarSlots.end()) {
+                m_BatchColumns[it->second.slot] = column.second;
+            }
+        }
+        return m_evalBatch(vCount, vOut, vErrors);
+    }
+
+    // Method to evaluate the expression for vCount rows without throwing, with the columns of the variables given by handle
+    ErrorCode tryEvalBatch(const size_t vCount, const ::std::vector< ::std::pair<VarHandle, const double*> >& vColumns, double* vOut, ErrorCode* vErrors = nullptr) {
+        m_BatchColumns.assign(m_VarSources.size(), nullptr);
+        for (const auto& column : vColumns) {
+            m_BatchColumns[column.first.slot] = column.second;
+        }
+        return m_evalBatch(vCount, vOut, vErrors);
+    }
+
+    Expr& startTime() {
+        m_StartTime = ::std::chrono::steady_clock::now();  // Start time
+        return *this;
+    }
+
+    Expr& endTime() {
+        m_EndTime = ::std::chrono::steady_clock::now();  // End time
+        return *this;
+    }
+
+    // Returns the evaluation time in milliseconds
+    double getEvalTime() {
+        m_Elapsed = m_EndTime - m_StartTime;
+        return m_Elapsed.count();
+    }
+
+    // Method to add a constant
+    Expr& addConstant(const String& vName, const double vValue) {
+        m_Constant[vName]          = vValue;  // Add the constant
+        m_RegistryDirty = true;
+        return *this;
+    }
+
+    // Method to add a unary function
+    // a pure function (same result for same arguments and no side effects) is folded when its arguments are constants
+    Expr& addFunction(const String& vName, const UnaryFunctor& functor, const bool vIsPure = false) {
+        Function fun;
+        fun.isPure         = vIsPure;
+        fun.unaryFunctor   = functor;
+        fun.argCount       = 1;
+        m_Functions[vName] = fun;
+        ++m_FunctionsRevision;  // the functions resolved by the program must be resolved again
+        m_RegistryDirty = true;
+        return *this;
+    }
+
+    // Method to add a binary function
+    // a pure function (same result for same arguments and no side effects) is folded when its arguments are constants
+    Expr& addFunction(const String& vName, const BinaryFunctor& functor, const bool vIsPure = false) {
+        Function fun;
+        fun.isPure         = vIsPure;
+        fun.binaryFunctor  = functor;
+        fun.argCount       = 2;
+        m_Functions[vName] = fun;
+        ++m_FunctionsRevision;  // the functions resolved by the program must be resolved again
+        m_RegistryDirty = true;
+        return *this;
+    }
+
+    // Method to add a ternary function
+    // a pure function (same result for same arguments and no side effects) is folded when its arguments are constants
+    Expr& addFunction(const String& vName, const TernaryFunctor& functor, const bool vIsPure = false) {
+        Function fun;
+        fun.isPure         = vIsPure;
         fun.ternaryFunctor = functor;
         fun.argCount       = 3;
         m_Functions[vName] = fun;
+        ++m_FunctionsRevision;  // the functions resolved by the program must be resolved again
+        m_RegistryDirty = true;
+        return *this;
+    }
+
+    // Method to enable or disable verbose mode
+    Expr& setVerbose(bool vVerbose) {
+        m_Verbose = vVerbose;
+        return *this;
+    }
+
+    // Method to enable or disable the constant folding, enabled by default
+    Expr& setConstantFolding(bool vEnabled) {
+        m_ConstantFolding = vEnabled;
+        m_compile();
+        return *this;
+    }
+
+    // Method to select the algebraic simplifications, none by default
+    // EXACT keeps bit identical results, FAST may change the rounding of the results
+    Expr& setSimplification(SimplificationMode vMode) {
+        m_Simplification = vMode;
+        m_compile();
+        return *this;
+    }
+
+    // Method to enable or disable the common subexpressions elimination, enabled by default
+    Expr& setCommonSubexpressionElimination(bool vEnabled) {
+        m_CommonSubexpressions = vEnabled;
+        m_compile();
+        return *this;
+    }
+
+    // Method to select the instruction set used by the batch evaluation, the best supported by the cpu by default
+    // an instruction set not supported is replaced by the best supported one
+    // only InstructionSet::SCALAR gives the results of eval() bit for bit, SSE2 and AVX2 computing exp, log, log2, log10,
+    // sin, cos, tan, atan2 and pow within 2 ulp of the standard library
+    Expr& setInstructionSet(InstructionSet vInstructionSet) {
+        m_Kernels = &simd::getKernels(vInstructionSet);
+        m_compile();
+        return *this;
+    }
+
+    // Returns the instruction set used by the batch evaluation
+    InstructionSet getInstructionSet() const {
+        return m_Kernels->instructionSet;
+    }
+
+    // Set the checks of the errors during the evaluation and the batch evaluation
+    Expr& setErrorCheckPolicy(ErrorCheckPolicy vPolicy) {
+        m_ErrorCheck         = vPolicy;
+        m_Program.errorCheck = vPolicy;  // no need to recompile
+        if (m_Jit != nullptr) {
+            m_Jit = JitProgram::create(m_Program);  // the checks are compiled in the native code
+        }
+        return *this;
+    }
+
+    // Returns the checks of the errors during the evaluation
+    ErrorCheckPolicy getErrorCheckPolicy() const {
+        return m_ErrorCheck;
+    }
+
+    // Method to enable or disable the compilation of the program in native code, disabled by default
+    // only on Linux x86-64 (the interpreter is used elsewhere), for eval and the contexts of compile, not for evalBatch
+    // on an error the evaluation is done again by the interpreter, so the impure functions can be called twice
+    Expr& setJitCompilation(bool vEnabled) {
+        m_JitCompilation = vEnabled;
+        m_compile();
+        return *this;
+    }
+
+    // Returns true if the program is compiled in native code
+    bool isJitCompiled() const {
+        return m_Jit != nullptr;
+    }
+
+    // Set the count of threads of the batch evaluation, 0 for the count of hardware threads
+    // the functions added by the user must then support to be called from several threads
+    Expr& setThreadsCount(size_t vThreadsCount) {
+        if (vThreadsCount == 0U) {
+            vThreadsCount = ::std::max<size_t>(::std::thread::hardware_concurrency(), 1U);
+        }
+        if (vThreadsCount != getThreadsCount()) {
+            m_ThreadPool.reset(vThreadsCount > 1U ? new ThreadPool(vThreadsCount) : nullptr);
+        }
+        return *this;
+    }
+
+    // Returns the count of threads of the batch evaluation
+    size_t getThreadsCount() const {
+        return m_ThreadPool != nullptr ? m_ThreadPool->getThreadsCount() : 1U;
+    }
+
+    // Returns the program lowered from the syntax tree
+    const Program& getProgram() const {
+        return m_Program;
+    }
+
+    // Compile the expression in an immutable program, shareable between threads and evaluated by EvalContext
+    // the values of the variables defined at this time are the default values of the contexts
+    ::std::shared_ptr<const CompiledExpr> compile();
+
+    // Method to generate a standalone C++ function evaluating the expression, for an ahead-of-time compilation
+    // the arguments are the variables in the order of their slots (order of first appearance in the expression)
+    // the results are the ones of ErrorCheckPolicy::NONE, the builtins are inlined with the same definitions
+    // the other functions are called by their name and must be declared before, <cmath> and <limits> are needed
+    // a variable named like a C++ keyword or a macro of the standard headers (new, int, NAN..) is given with a '_' appended
+    String toCppSource(const String& vFunctionName) {
+        m_clearError();
+        if (m_Program.functionsRevision != m_FunctionsRevision && m_compile() != ErrorCode::NONE) {
+            m_throwError(m_Error.code, m_Error.message);  // the functions called or folded by the program may have changed
+        }
+        ::std::stringstream src;
+        src << "// " << m_Expr.c_str() << "\n";
+        src << "inline double " << vFunctionName.c_str() << "(";
+        for (size_t idx = 0; idx < m_Program.variables.size(); ++idx) {
+            src << (idx != 0U ? ", " : "") << "double " << m_getCppName(m_Program.variables[idx]);
+        }
+        src << ") {\n";
+        ::std::vector< ::std::string> stack;  // source of each value of the stack, a name or a number
+        ::std::vector< ::std::string> temps(m_Program.tempsCount);
+        size_t resultsCount = 0U;
+        for (const auto& ins : m_Program.code) {
+            switch (ins.op) {
+                case OpCode::PUSH_NUMBER: stack.push_back(m_getCppNumber(m_Program.constants[ins.arg])); break;
+                case OpCode::PUSH_VARIABLE: stack.push_back(m_getCppName(m_Program.variables[ins.arg])); break;
+                case OpCode::STORE_TEMP: temps[ins.arg] = stack.back(); break;
+                case OpCode::LOAD_TEMP: stack.push_back(temps[ins.arg]); break;
+                default: {
+                    ::std::string code;
+                    size_t argCount = 1U;
+                    m_getCppOperation(ins, code, argCount);
+                    const ::std::string result = "ez_r" + ::std::to_string(resultsCount++);
+                    if (code.find("$r") == ::std::string::npos) {
+                        code = "const double $r = " + code + ";";
+                    }
+                    for (size_t arg = 0; arg < argCount; ++arg) {
+                        m_replaceAll(code, "$" + ::std::to_string(arg), stack[stack.size() - argCount + arg]);
+                    }
+                    m_replaceAll(code, "$r", result);
+                    m_replaceAll(code, "\n", "\n    ");
+                    src << "    " << code << "\n";
+                    stack.resize(stack.size() - argCount);
+                    stack.push_back(result);
+                }
+            }
+        }
+        src << "    return " << (stack.empty() ? "0.0" : stack.back()) << ";\n}\n";
+        return src.str();
+    }
+
+    // Returns the evaluation result
+    double getResult() {
+        return m_EvalResult;
+    }
+
+    // Returns the error of the last parsing or evaluation, its code being ErrorCode::NONE if it succeeded
+    const ExprError& getError() const {
+        return m_Error;
+    }
+
+    // Prints the expression and its result
+    Expr& print() {
+        m_syncDefinedVars();
+        m_printExpr = {};
+        m_printExpr << "Expr \"" << m_Expr << "\"";
+        for (const auto& it : m_DefinedVariables) {
+            m_printExpr << ", " << it.first << " = " << it.second;
+        }
+        m_printExpr << " => " << m_EvalResult;
+        ::std::cout << m_printExpr.str() << " (" << getEvalTime() << " ms)" << ::std::endl;
+        return *this;
+    }
+
+    // Checks if the evaluation result is close to a given value
+    bool check(const double vValue) {
+        return (::std::abs(m_EvalResult - vValue) < 0.001);
+    }
+
+    // test if a variable found during parsing exist
+    bool isParsedVariableExist(const String& vName) {
+        return (m_ParsedVariables.find(vName) != m_ParsedVariables.end());
+    }
+
+    // Returns variables as a constant reference
+    // the references and iterators to its entries are invalidated by the next parsing, like the ones of a vector
+    const VarContainer& getParsedVars() {
+        return m_ParsedVariables;
+    }
+
+    // Returns variables as a modifiable reference
+    // the references and iterators to its entries are invalidated by the next parsing and by an insertion or an erasure
+    VarContainer& getParsedVarsRef() {
+        return m_ParsedVariables;
+    }
+
+    // test if a defined variable exist
+    bool isDefinedVariableExist(const String& vName) {
+        m_syncDefinedVars();
+        return (m_DefinedVariables.find(vName) != m_DefinedVariables.end());
+    }
+
+    // Returns defined variables as a constant reference
+    // the references and iterators to its entries are invalidated by the set of a new variable, like the ones of a vector
+    const VarContainer& getDefinedVars() {
+        m_syncDefinedVars();
+        return m_DefinedVariables;
+    }
+
+    // Returns defined variables as a modifiable reference
+    // the modifications are applied to the parsed variables at the next set or evaluation
+    // the references and iterators to its entries are invalidated by the set of a new variable and by an insertion or an erasure
+    VarContainer& getDefinedVarsRef() {
+        m_syncDefinedVars();
+        m_DefinedVarsDirty = true;
+        return m_DefinedVariables;
+    }
+
+protected:
+    // Returns the 64 bits hash of a name (FNV-1a), the seed separating the kinds of names
+    static uint64_t m_hashName(const String& vName, const uint64_t vSeed) {
+        uint64_t hash    = 14695981039346656037ULL ^ vSeed;
+        const char* data = vName.c_str();
+        for (size_t idx = 0; idx < vName.length(); ++idx) {
+            hash = (hash ^ static_cast<uint8_t>(data[idx])) * 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    // Mix the bits of a hash (finalizer of splitmix64)
+    static uint64_t m_mixHash(uint64_t vHash) {
+        vHash = (vHash ^ (vHash >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+        vHash = (vHash ^ (vHash >> 27U)) * 0x94D049BB133111EBULL;
+        return vHash ^ (vHash >> 31U);
+    }
+
+    // Returns the snapshot of the constants and functions compared by the parse cache, built again after their modification
+    const ::std::shared_ptr<const RegistrySnapshot>& m_getRegistry() {
+        if (m_RegistryDirty || m_Registry == nullptr) {
+            auto registry = ::std::make_shared<RegistrySnapshot>();
+            registry->entries.reserve(m_Constant.size() + m_Functions.size());
+            for (const auto& constant : m_Constant) {
+                RegistrySnapshot::Entry entry;
+                entry.name = constant.first;
+                ::std::memcpy(&entry.value, &constant.second, sizeof(entry.value));
+                registry->entries.push_back(entry);
+            }
+            for (const auto& function : m_Functions) {
+                RegistrySnapshot::Entry entry;
+                entry.name       = function.first;
+                entry.value      = function.second.argCount;
+                entry.isFunction = true;
+                entry.isPure     = function.second.isPure;
+                entry.builtin    = function.second.builtin;
+                registry->entries.push_back(entry);
+            }
+            ::std::sort(registry->entries.begin(), registry->entries.end(), [](const RegistrySnapshot::Entry& vA, const RegistrySnapshot::Entry& vB) {
+                return vA.isFunction != vB.isFunction ? vB.isFunction : ::std::strcmp(vA.name.c_str(), vB.name.c_str()) < 0;
+            });
+            uint64_t fingerprint = 0U;
+            for (const auto& entry : registry->entries) {
+                const uint64_t flags = (entry.isFunction ? 1U : 0U) | (entry.isPure ? 2U : 0U) | (static_cast<uint64_t>(entry.builtin) << 8U);
+                fingerprint          = m_mixHash(fingerprint ^ m_hashName(entry.name, flags) ^ entry.value);
+            }
+            registry->fingerprint = fingerprint;
+            m_Registry            = registry;
+            m_RegistryDirty       = false;
+        }
+        return m_Registry;
+    }
+
+    // Returns the settings of the compilation changing the program
+    CompileSettings m_getCompileSettings() const {
+        CompileSettings settings;
+        settings.constantFolding      = m_ConstantFolding;
+        settings.simplification       = m_Simplification;
+        settings.commonSubexpressions = m_CommonSubexpressions;
+        settings.errorCheck           = m_ErrorCheck;
+        return settings;
+    }
+
+    // Returns true if the program can be shared by the parse cache, so if it doesn't depend on the functors of this expression
+    // the functors of the user pure functions can be called by the constant folding
+    bool m_isProgramShareable() const {
+        if (!m_ConstantFolding) {
+            return true;
+        }
+        for (const auto& node : m_Tree->nodes) {
+            if (node.type == NodeType::FUNCTION) {
+                auto it = m_Functions.find(node.name);
+                if (it != m_Functions.end() && it->second.isPure && it->second.builtin == BuiltinId::NONE) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    static bool m_isDigit(const char vCh) {
+        return vCh >= '0' && vCh <= '9';
+    }
+
+    static bool m_isAlpha(const char vCh) {
+        return (vCh >= 'a' && vCh <= 'z') || (vCh >= 'A' && vCh <= 'Z');
+    }
+
+    static bool m_isAlnum(const char vCh) {
+        return m_isDigit(vCh) || m_isAlpha(vCh);
+    }
+
+    static bool m_isSpace(const char vCh) {
+        return vCh == ' ' || (vCh >= '\t' && vCh <= '\r');
+    }
+
+    // Read a number starting at vPos : digits, point, digits and an exponent if followed by digits
+    // returns the offset after the number, vValue being the nearest double of the literal whatever the locale
+    static size_t m_readNumber(const char* vExpr, size_t vPos, double& vValue) {
+        // the significant digits, enough to round correctly any literal, and one more digit for the dropped ones
+        char digits[s_MaxNumberDigits + 16U];
+        size_t count    = 0U;
+        int32_t scale   = 0;  // the literal is the integer of the digits * 10^scale
+        bool hasDigits  = false;
+        bool hasDropped = false;
+        bool isFraction = false;
+        for (;; ++vPos) {
+            const char ch = vExpr[vPos];
+            if (ch == '.' && !isFraction) {
+                isFraction = true;
+            } else if (m_isDigit(ch)) {
+                hasDigits = true;
+                if (count == 0U && ch == '0') {
+                    scale -= isFraction ? 1 : 0;  // leading zero
+                } else if (count < s_MaxNumberDigits) {
+                    digits[count++] = ch;
+                    scale -= isFraction ? 1 : 0;
+                } else {
+                    hasDropped = hasDropped || (ch != '0');
+                    scale += isFraction ? 0 : 1;
+                }
+            } else {
+                break;
+            }
+        }
+        if (hasDigits && (vExpr[vPos] == 'e' || vExpr[vPos] == 'E')) {
+            size_t pos       = vPos + 1U;
+            const bool isNeg = (vExpr[pos] == '-');
+            if (vExpr[pos] == '-' || vExpr[pos] == '+') {
+                ++pos;
+            }
+            if (m_isDigit(vExpr[pos])) {
+                int32_t exponent = 0;
+                for (; m_isDigit(vExpr[pos]); ++pos) {
+                    if (exponent < 100000) {  // far from the range of the doubles, so the value is 0 or Inf
+                        exponent = exponent * 10 + (vExpr[pos] - '0');
+                    }
+                }
+                scale += isNeg ? -exponent : exponent;
+                vPos = pos;
+            }
+        }
+        if (count == 0U) {
+            vValue = 0.0;
+            return vPos;
+        }
+        if (hasDropped) {
+            digits[count++] = '1';  // between the kept digits and the next ones, for the rounding
+            --scale;
+        }
+        // exact if the integer and the power of ten are exact doubles
+        static const double s_Powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        if (count <= 19U && scale >= -22 && scale <= 22) {
+            uint64_t mantissa = 0U;
+            for (size_t idx = 0; idx < count; ++idx) {
+                mantissa = mantissa * 10U + static_cast<uint64_t>(digits[idx] - '0');
+            }
+            if (mantissa <= (1ULL << 53U)) {
+                vValue = scale < 0 ? static_cast<double>(mantissa) / s_Powers[-scale] : static_cast<double>(mantissa) * s_Powers[scale];
+                return vPos;
+            }
+        }
+        // else the digits are given to strtod without decimal point, so the locale is not used
+        digits[count++] = 'e';
+        if (scale < 0) {
+            digits[count++] = '-';
+            scale           = -scale;
+        }
+        char exponent[12];
+        size_t length = 0U;
+        do {
+            exponent[length++] = static_cast<char>('0' + scale % 10);
+            scale /= 10;
+        } while (scale != 0);
+        while (length != 0U) {
+            digits[count++] = exponent[--length];
+        }
+        digits[count] = '\0';
+        vValue        = ::std::strtod(digits, nullptr);  // Inf if out of range, reported at evaluation
+        return vPos;
+    }
+
+    // Returns the characters of a token
+    String m_getTokenText(const Token& vToken) const {
+        return String(m_Expr.c_str() + vToken.offset, vToken.length);
+    }
+
+    // Tokenize the expression in vTokens, the buffer being read in place
+    void m_tokenize(const char* expr, ::std::vector<Token>& vTokens) {
+        vTokens.clear();
+        size_t pos = 0U;
+        for (;;) {
+            while (m_isSpace(expr[pos])) {
+                ++pos;
+            }
+            const char ch = expr[pos];
+            if (ch == '\0') {
+                break;
+            }
+            Token token;
+            token.offset = pos;
+            if (m_isDigit(ch) || ch == '.') {
+                token.type = TokenType::NUMBER;
+                pos        = m_readNumber(expr, pos, token.value);
+            } else if (m_isAlpha(ch)) {
+                token.type = TokenType::VARIABLE;  // Traitement g�n�rique comme identifiant
+                while (m_isAlnum(expr[++pos])) {
+                }
+            } else if (ch == '(') {
+                token.type = TokenType::LPAREN;
+                ++pos;
+            } else if (ch == ')') {
+                token.type = TokenType::RPAREN;
+                ++pos;
+            } else if (ch == ',') {
+                token.type = TokenType::SEPARATOR;
+                ++pos;
+            } else {
+                // the characters of an operator are read until a letter, a digit, a space, a parenthesis or a comma
+                token.type = TokenType::OPERATOR;
+                for (char next = expr[++pos]; next != '\0' && !m_isAlnum(next) && next != ' ' && next != '(' && next != ')' && next != ','; next = expr[++pos]) {
+                }
+                token.op = (pos - token.offset == 1U) ? m_getOperatorCode(ch) : OpCode::Count;
+            }
+            token.length = pos - token.offset;
+            vTokens.push_back(token);
+        }
+        if (m_Verbose) {
+            m_log("Tokens: ");
+            for (const auto& token : vTokens) {
+                m_log(m_getTokenText(token) + " ");
+            }
+            m_log("\n");
+        }
+    }
+
+    // Add a builtin function, pure and with a known behavior
+    template <typename TFunctor>
+    void m_addBuiltin(const BuiltinId vId, const String& vName, const TFunctor& vFunctor) {
+        addFunction(vName, vFunctor, true);
+        m_Functions[vName].builtin = vId;
+    }
+
+    // Returns the code of an operator, OpCode::Count if the operator is unknown
+    static OpCode m_getOperatorCode(const char vOp) {
+        switch (vOp) {
+            case '+': return OpCode::ADD;
+            case '-': return OpCode::SUB;
+            case '*': return OpCode::MUL;
+            case '/': return OpCode::DIV;
+            case '^': return OpCode::POW;
+            case '%': return OpCode::MOD;
+            case '!': return OpCode::FACTORIAL;
+            default: break;
+        }
+        return OpCode::Count;
+    }
+
+    // Returns the precedence of a binary operator, 0 if the code is not a binary operator
+    static int m_getPrecedence(const OpCode vOp) {
+        static const int s_precedences[static_cast<size_t>(OpCode::Count) + 1U] = {
+            0,  // PUSH_NUMBER
+            0,  // PUSH_VARIABLE
+            1,  // ADD
+            1,  // SUB
+            2,  // MUL
+            2,  // DIV
+            3,  // POW
+            2,  // MOD
+            0,  // NEG
+            0,  // POWI
+            0,  // SQRT
+            0,  // STORE_TEMP
+            0,  // LOAD_TEMP
+            0,  // CALL_UNARY
+            0,  // CALL_BINARY
+            0,  // CALL_TERNARY
+            0,  // FACTORIAL
+            0,  // Count
+        };
+        return s_precedences[static_cast<size_t>(vOp)];
+    }
+
+    // Logs messages if verbose mode is enabled
+    void m_log(const String& message) {
+        if (m_Verbose) {
+            ::std::cout << message.c_str();
+        }
+    }
+
+    // Store an error in vError and returns its code
+    static ErrorCode m_fail(ExprError& vError, const ErrorCode vCode, const String& vMessage) {
+        vError.code    = vCode;
+        vError.message = vMessage;
+        return vCode;
+    }
+
+    // Forget the error of the last parsing or evaluation
+    void m_clearError() {
+        if (m_Error.code != ErrorCode::NONE) {
+            m_Error = ExprError();
+        }
+    }
+
+    // Throw an error as an ExprException, nothing for ErrorCode::NONE
+    // if the exceptions are disabled, the program is aborted like by the standard library, the try functions must be used
+    static void m_throwError(const ErrorCode vCode, const String& vMessage) {
+        if (vCode != ErrorCode::NONE) {
+#ifdef USE_EXCEPTIONS
+            throw ExprException(vCode, vMessage);
+#else
+            ::std::cerr << "EzExpr error : " << vMessage << ::std::endl;
+            ::std::abort();
+#endif  // USE_EXCEPTIONS
+        }
+    }
+
+    // Assign a dense slot to each variable of the syntax tree, in order of appearance
+    void m_assignVarSlots(const uint32_t vNode) {
+        const Node& node = (*m_Tree)[vNode];
+        if (node.type == NodeType::VARIABLE && m_VarSlots.find(node.name) == m_VarSlots.end()) {
+            VarHandle handle;
+            handle.slot = static_cast<uint32_t>(m_Program.variables.size());
+            m_VarSlots.emplace(node.name, handle);
+            m_Program.variables.push_back(node.name);
+            m_ParsedVariables[node.name] = 0.0;  // Ajout de la variable trouv�e avec une valeur par d�faut de 0.0
+        }
+        for (size_t idx = 0; idx < node.childCount; ++idx) {
+            m_assignVarSlots(node.childs[idx]);
+        }
+    }
+
+    // Lower the syntax tree into a flat postorder program, the variables slots are kept
+    // done at parsing and again at evaluation if the functions container was modified since
+    // on error the functions revision of the program is not updated, so the error is reported again at evaluation
+    ErrorCode m_compile() {
+        SyntaxTree tree = *m_Tree;  // the optimizations work on a copy of the parsed tree
+        if (m_ConstantFolding) {
+            m_foldNode(tree, tree.root);
+        }
+        if (m_Simplification != SimplificationMode::NONE) {
+            m_simplifyNode(tree, tree.root);
+        }
+        m_Program.code.clear();
+        m_Program.constants.clear();
+        m_Program.functions.clear();
+        m_Program.stackSize  = 0U;
+        m_Program.tempsCount = 0U;
+        size_t depth         = 0U;
+        ErrorCode code       = ErrorCode::NONE;
+        if (m_CommonSubexpressions) {
+            size_t bucketsCount = 16U;
+            while (bucketsCount < tree.nodes.size() * 2U) {
+                bucketsCount *= 2U;  // at most half full, a node being inserted at most once
+            }
+            m_SharedNodes.assign(bucketsCount, SharedNode());
+            m_shareChilds(tree, tree.root);
+            EmitState& state = m_EmitState;
+            state.refsCount.assign(tree.nodes.size(), 0U);
+            state.temps.assign(tree.nodes.size(), 0U);
+            m_countRefs(tree, tree.root, state);
+            code = m_emitNode(tree, tree.root, m_Program, depth, m_Error, &state);
+        } else {
+            code = m_emitNode(tree, tree.root, m_Program, depth, m_Error);
+        }
+        return m_linkProgram(code);
+    }
+
+    // Resolve the functions of the lowered program in the functions container and prepare its evaluation
+    ErrorCode m_linkProgram(ErrorCode vCode) {
+        if (vCode == ErrorCode::NONE) {
+            vCode = m_resolveFunctions(m_Program, m_Error);
+        }
+        m_Program.errorCheck = m_ErrorCheck;  // the folding always checks every node, so the errors are never folded
+        m_Stack.resize(m_Program.stackSize + m_Program.tempsCount);  // the temporaries are stored after the stack
+        m_Jit.reset();
+        if (vCode == ErrorCode::NONE && m_JitCompilation) {
+            m_Jit = JitProgram::create(m_Program);  // nullptr if not supported, the interpreter being then used
+        }
+        return vCode;
+    }
+
+    // Get the structural key of a node whose childs are already shared, returns false if the node must not be shared
+    bool m_getNodeKey(const Node& node, NodeKey& vKey) const {
+        switch (node.type) {
+            case NodeType::NUMBER: ::std::memcpy(&vKey.bits, &node.value, sizeof(vKey.bits)); break;
+            case NodeType::VARIABLE: vKey.name = &node.name; break;
+            case NodeType::OPERATOR: ::std::memcpy(&vKey.bits, &node.value, sizeof(vKey.bits)); break;  // exponent of a POWI node
+            case NodeType::FUNCTION: {
+                auto it = m_Functions.find(node.name);
+                if (it == m_Functions.end() || !it->second.isPure) {
+                    return false;  // each call of an impure function is evaluated
+                }
+                vKey.name = &node.name;
+            } break;
+            default: return false;
+        }
+        vKey.type       = node.type;
+        vKey.op         = node.op;
+        vKey.childCount = static_cast<uint32_t>(node.childCount);
+        for (size_t idx = 0; idx < node.childCount; ++idx) {
+            vKey.childs[idx] = node.childs[idx];
+        }
+        return true;
+    }
+
+    // Returns the hash of a node key
+    static uint64_t m_hashNodeKey(const NodeKey& vKey) {
+        uint64_t hash = static_cast<uint64_t>(vKey.type) | (static_cast<uint64_t>(vKey.op) << 8U) | (static_cast<uint64_t>(vKey.childCount) << 16U);
+        hash          = m_mixHash(hash ^ vKey.bits);
+        hash          = m_mixHash(hash ^ (vKey.name != nullptr ? vKey.name->getHash() : 0U));
+        hash          = m_mixHash(hash ^ vKey.childs[0] ^ (static_cast<uint64_t>(vKey.childs[1]) << 32U));
+        return m_mixHash(hash ^ vKey.childs[2]);
+    }
+
+    // Returns the node of the same key met before, vNode if none
+    uint32_t m_shareNode(const NodeKey& vKey, const uint32_t vNode) {
+        const size_t mask = m_SharedNodes.size() - 1U;
+        for (size_t pos = static_cast<size_t>(m_hashNodeKey(vKey)) & mask;; pos = (pos + 1U) & mask) {
+            SharedNode& shared = m_SharedNodes[pos];
+            if (shared.key.type == NodeType::Count) {
+                shared.key  = vKey;
+                shared.node = vNode;
+                return vNode;
+            }
+            if (shared.key == vKey) {
+                return shared.node;  // identical to a subtree met before
+            }
+        }
+    }
+
+    // Share the structurally identical subtrees of the childs of a node, so the tree becomes a DAG
+    void m_shareChilds(SyntaxTree& vTree, const uint32_t vNode) {
+        for (size_t idx = 0; idx < vTree[vNode].childCount; ++idx) {
+            uint32_t& child = vTree[vNode].childs[idx];
+            m_shareChilds(vTree, child);
+            NodeKey key;
+            if (m_getNodeKey(vTree[child], key)) {
+                child = m_shareNode(key, child);
+            }
+        }
+    }
+
+    // Count the references of the nodes of a DAG
+    static void m_countRefs(const SyntaxTree& vTree, const uint32_t vNode, EmitState& vState) {
+        const Node& node = vTree[vNode];
+        for (size_t idx = 0; idx < node.childCount; ++idx) {
+            const uint32_t child = node.childs[idx];
+            if (++vState.refsCount[child] == 1U) {
+                m_countRefs(vTree, child, vState);
+            }
+        }
+    }
+
+    // Resolve the functions called by a program in the functions container
+    ErrorCode m_resolveFunctions(Program& vProgram, ExprError& vError) {
+        for (auto& fun : vProgram.functions) {
+            auto it = m_Functions.find(fun.name);
+            if (it == m_Functions.end()) {
+                return m_fail(vError, ErrorCode::FUNCTION_NOT_FOUND, "Function not found: " + fun.name);
+            }
+            if (it->second.argCount != fun.argCount) {
+                return m_fail(vError, ErrorCode::FUNCTION_WRONG_ARGUMENTS_COUNT, "Incorrect number of arguments for function: " + fun.name);
+            }
+            fun.function = &it->second;
+            m_resolveKernel(fun);
+        }
+        vProgram.functionsRevision = m_FunctionsRevision;
+        vProgram.kernels           = m_Kernels;
+        return ErrorCode::NONE;
+    }
+
+    // Select the kernel used by the batch evaluation for a builtin function
+    void m_resolveKernel(ProgramFunction& vFunction) const {
+        const simd::Kernels& k = *m_Kernels;
+        vFunction.unaryKernel   = nullptr;
+        vFunction.binaryKernel  = nullptr;
+        vFunction.ternaryKernel = nullptr;
+        switch (vFunction.function->builtin) {
+            case BuiltinId::ABS: vFunction.unaryKernel = k.abs; break;
+            case BuiltinId::FRACT: vFunction.unaryKernel = k.fract; break;
+            case BuiltinId::SIGN: vFunction.unaryKernel = k.sign; break;
+            case BuiltinId::SQRT: vFunction.unaryKernel = k.sqrt; break;
+            case BuiltinId::SATURATE: vFunction.unaryKernel = k.saturate; break;
+            case BuiltinId::MIN: vFunction.binaryKernel = k.min; break;
+            case BuiltinId::MAX: vFunction.binaryKernel = k.max; break;
+            case BuiltinId::STEP: vFunction.binaryKernel = k.step; break;
+            case BuiltinId::CLAMP: vFunction.ternaryKernel = k.clamp; break;
+            case BuiltinId::LERP:
+            case BuiltinId::MIX: vFunction.ternaryKernel = k.mix; break;
+            case BuiltinId::SMOOTHSTEP: vFunction.ternaryKernel = k.smoothstep; break;
+            case BuiltinId::EXP: vFunction.unaryKernel = k.exp; break;
+            case BuiltinId::LN:
+            case BuiltinId::LOG: vFunction.unaryKernel = k.log; break;
+            case BuiltinId::LOG2: vFunction.unaryKernel = k.log2; break;
+            case BuiltinId::LOG10: vFunction.unaryKernel = k.log10; break;
+            case BuiltinId::SIN: vFunction.unaryKernel = k.sin; break;
+            case BuiltinId::COS: vFunction.unaryKernel = k.cos; break;
+            case BuiltinId::TAN: vFunction.unaryKernel = k.tan; break;
+            case BuiltinId::ATAN2: vFunction.binaryKernel = k.atan2; break;
+            default: break;  // called row by row
+        }
+    }
+
+    // Replace the constant subtrees by their value, returns true if the node is a number after folding
+    // a subtree raising an error is kept as is, so the error is reported at evaluation
+    bool m_foldNode(SyntaxTree& vTree, const uint32_t vNode) {
+        Node& node = vTree[vNode];
+        if (node.type == NodeType::NUMBER) {
+            return true;
+        } else if (node.type == NodeType::VARIABLE) {
+            return false;
+        }
+        bool isConstant = true;
+        for (size_t idx = 0; idx < node.childCount; ++idx) {
+            if (!m_foldNode(vTree, node.childs[idx])) {
+                isConstant = false;
+            }
+        }
+        if (!isConstant) {
+            return false;
+        }
+        if (node.type == NodeType::FUNCTION) {
+            auto it = m_Functions.find(node.name);
+            if (it == m_Functions.end() || !it->second.isPure) {
+                return false;  // a function with side effects must be called at each evaluation
+            }
+        }
+        // the childs are numbers, so the node is evaluated with the same code than the evaluation
+        Program program;
+        size_t depth = 0U;
+        ::std::array<double, 3> stack{};
+        double value = 0.0;
+        ExprError error;  // not reported, the subtree is evaluated again at evaluation
+        bool isFolded = false;
+#ifdef USE_EXCEPTIONS
+        try {
+#endif  // USE_EXCEPTIONS
+            isFolded = m_emitNode(vTree, vNode, program, depth, error) == ErrorCode::NONE && m_resolveFunctions(program, error) == ErrorCode::NONE && m_run(program, nullptr, stack.data(), value, error, false) == ErrorCode::NONE;
+#ifdef USE_EXCEPTIONS
+        } catch (const ExprException&) {
+            isFolded = false;  // thrown by a function added by the user
+        }
+#endif  // USE_EXCEPTIONS
+        if (!isFolded) {
+            return false;
+        }
+        node       = Node();
+        node.type  = NodeType::NUMBER;
+        node.value = value;
+        return true;
+    }
+
+    // Returns true if the node is the number vValue
+    static bool m_isNumber(const Node& node, const double vValue) {
+        return node.type == NodeType::NUMBER && node.value == vValue;
+    }
+
+    // Replace a node by one of its childs, the child and the nodes under it being kept in place
+    static void m_replaceByChild(SyntaxTree& vTree, const uint32_t vNode, const size_t vIdx) {
+        vTree[vNode] = vTree[vTree[vNode].childs[vIdx]];
+    }
+
+    // Apply the algebraic simplifications and the strength reductions to a node, after its childs
+    void m_simplifyNode(SyntaxTree& vTree, const uint32_t vNode) {
+        for (size_t idx = 0; idx < vTree[vNode].childCount; ++idx) {
+            m_simplifyNode(vTree, vTree[vNode].childs[idx]);
+        }
+        Node& node        = vTree[vNode];
+        const bool isFast = (m_Simplification == SimplificationMode::FAST);
+        bool isPow        = false;
+        if (node.type == NodeType::OPERATOR) {
+            const Node& left = vTree[node.childs[0]];
+            switch (node.op) {
+                case OpCode::ADD: {
+                    if (isFast && m_isNumber(vTree[node.childs[1]], 0.0)) {  // x + 0 => x, -0 + 0 is +0
+                        m_replaceByChild(vTree, vNode, 0);
+                    } else if (isFast && m_isNumber(left, 0.0)) {  // 0 + x => x
+                        m_replaceByChild(vTree, vNode, 1);
+                    }
+                } break;
+                case OpCode::SUB: {
+                    if (m_isNumber(vTree[node.childs[1]], 0.0)) {  // x - 0 => x
+                        m_replaceByChild(vTree, vNode, 0);
+                    }
+                } break;
+                case OpCode::MUL: {
+                    if (m_isNumber(vTree[node.childs[1]], 1.0)) {  // x * 1 => x
+                        m_replaceByChild(vTree, vNode, 0);
+                    } else if (m_isNumber(left, 1.0)) {  // 1 * x => x
+                        m_replaceByChild(vTree, vNode, 1);
+                    }
+                } break;
+                case OpCode::DIV: {
+                    if (m_isNumber(vTree[node.childs[1]], 1.0)) {  // x / 1 => x
+                        m_replaceByChild(vTree, vNode, 0);
+                    }
+                } break;
+                case OpCode::NEG: {
+                    if (left.type == NodeType::OPERATOR && left.op == OpCode::NEG) {  // -(-x) => x
+                        node = vTree[left.childs[0]];
+                    }
+                } break;
+                case OpCode::POW: {
+                    isPow = true;
+                } break;
+                default: break;
+            }
+        } else if (node.type == NodeType::FUNCTION && node.childCount == 2 && node.name == "pow") {
+            auto it = m_Functions.find(node.name);
+            isPow   = (it != m_Functions.end() && it->second.builtin == BuiltinId::POW);  // a user pow can have another behavior
+        }
+        if (isPow && vTree[node.childs[1]].type == NodeType::NUMBER) {
+            const double exponent = vTree[node.childs[1]].value;
+            const uint32_t base   = node.childs[0];
+            if (exponent == 1.0 || (isFast && exponent == ::std::floor(exponent) && ::std::abs(exponent) <= s_MaxIntegerPower && exponent != 0.0)) {
+                // x^n => x * x ... with the same check of the base than ::std::pow
+                node            = Node();
+                node.type       = NodeType::OPERATOR;
+                node.op         = OpCode::POWI;
+                node.value      = exponent;
+                node.childs[0]  = base;
+                node.childCount = 1;
+            } else if (isFast && exponent == 0.5) {  // x^0.5 => sqrt(x)
+                node            = Node();
+                node.type       = NodeType::OPERATOR;
+                node.op         = OpCode::SQRT;
+                node.childs[0]  = base;
+                node.childCount = 1;
+            }
+        }
+    }
+
+    // Copy the defined variables values and the bindings in the slots of the parsed variables
+    void m_loadDefinedVars() {
+        const auto count = m_Program.variables.size();
+        m_VarValues.assign(count, 0.0);
+        m_VarSources.assign(count, nullptr);
+        m_OffsetSlots.clear();
+        for (size_t idx = 0; idx < count; ++idx) {
+            const auto& name = m_Program.variables[idx];
+            auto bit         = m_VarBindings.find(name);
+            if (bit != m_VarBindings.end()) {
+                if (bit->second.isOffset) {
+                    m_OffsetSlots.emplace_back(static_cast<uint32_t>(idx), bit->second.offset);
+                    m_VarSources[idx] = m_getOffsetSource(bit->second.offset);
+                } else {
+                    m_VarSources[idx] = bit->second.ptr;
+                }
+                continue;
+            }
+            auto it = m_DefinedVariables.find(name);
+            if (it != m_DefinedVariables.end()) {
+                m_VarValues[idx]  = it->second;
+                m_VarSources[idx] = &m_VarValues[idx];
+            }
+        }
+        m_DefinedVarsDirty = false;
+    }
+
+    // Copy back the values of the set slots in the defined variables
+    void m_syncDefinedVars() {
+        if (m_DefinedVarsDirty) {
+            return;  // the container is the most recent one
+        }
+        for (size_t idx = 0; idx < m_Program.variables.size(); ++idx) {
+            if (m_VarSources[idx] == &m_VarValues[idx]) {
+                m_DefinedVariables[m_Program.variables[idx]] = m_VarValues[idx];
+                if (!m_VarBindings.empty()) {
+                    m_VarBindings.erase(m_Program.variables[idx]);  // the variable was set after its binding
+                }
+            }
+        }
+    }
+
+    // Register a binding and apply it to the parsed variables
+    Expr& m_bindVariable(const String& vName, const VarBinding& vBinding) {
+        m_syncDefinedVars();
+        m_VarBindings[vName] = vBinding;
+        m_loadDefinedVars();
+        return *this;
+    }
+
+    // Returns the address of a variable bound with an offset, nullptr if no base is set
+    const double* m_getOffsetSource(const size_t vOffset) const {
+        if (m_BindingBase == nullptr) {
+            return nullptr;
+        }
+        return reinterpret_cast<const double*>(m_BindingBase + vOffset);
+    }
+
+    // Emit the instructions of a node after the ones of its childs
+    // with a state, the nodes referenced several times are evaluated once and their value is kept in a temporary
+    ErrorCode m_emitNode(const SyntaxTree& vTree, const uint32_t vNode, Program& vProgram, size_t& vDepth, ExprError& vError, EmitState* vState = nullptr) {
+        const Node& node = vTree[vNode];
+        Instruction ins;
+        if (vState != nullptr && node.childCount != 0U) {
+            if (vState->temps[vNode] != 0U) {
+                ins.op  = OpCode::LOAD_TEMP;
+                ins.arg = vState->temps[vNode] - 1U;
+                if (++vDepth > vProgram.stackSize) {
+                    vProgram.stackSize = vDepth;
+                }
+                vProgram.code.push_back(ins);
+                return ErrorCode::NONE;
+            }
+        }
+        switch (node.type) {
+            case NodeType::NUMBER: {
+                ins.op  = OpCode::PUSH_NUMBER;
+                ins.arg = static_cast<uint32_t>(vProgram.constants.size());
+                vProgram.constants.push_back(node.value);
+            } break;
+            case NodeType::VARIABLE: {
+                auto it = m_VarSlots.find(node.name);
+                if (it == m_VarSlots.end()) {
+                    return m_fail(vError, ErrorCode::VARIABLE_NOT_FOUND, "Variable not found: " + node.name);
+                }
+                ins.op  = OpCode::PUSH_VARIABLE;
+                ins.arg = it->second.slot;
+            } break;
+            case NodeType::OPERATOR: {
+                ins.op = node.op;
+                if (node.op == OpCode::POWI) {
+                    ins.arg = static_cast<uint32_t>(static_cast<int32_t>(node.value));
+                }
+            } break;
+            case NodeType::FUNCTION: {
+                auto it = m_Functions.find(node.name);
+                const BuiltinId builtin = (it != m_Functions.end() && it->second.argCount == node.childCount) ? it->second.builtin : BuiltinId::NONE;
+                if (builtin == BuiltinId::POW) {
+                    ins.op = OpCode::POW;  // same checks of the base than the operator, at the node of the call
+                    break;
+                } else if (builtin == BuiltinId::FACT) {
+                    ins.op = OpCode::FACTORIAL;
+                    break;
+                }
+                switch (node.childCount) {
+                    case 1: ins.op = OpCode::CALL_UNARY; break;
+                    case 2: ins.op = OpCode::CALL_BINARY; break;
+                    case 3: ins.op = OpCode::CALL_TERNARY; break;
+                    default: return m_fail(vError, ErrorCode::FUNCTION_WRONG_ARGUMENTS_COUNT, "Incorrect number of arguments for function: " + node.name);
+                }
+                ins.arg = static_cast<uint32_t>(vProgram.functions.size());
+                ProgramFunction fun;
+                fun.name     = node.name;
+                fun.argCount = node.childCount;
+                vProgram.functions.push_back(fun);
+            } break;
+            default: return m_fail(vError, ErrorCode::UNKNOWN_NODE_TYPE, "Unknown node type");
+        }
+        for (size_t idx = 0; idx < node.childCount; ++idx) {
+            const ErrorCode code = m_emitNode(vTree, node.childs[idx], vProgram, vDepth, vError, vState);
+            if (code != ErrorCode::NONE) {
+                return code;
+            }
+        }
+        // the childs values are replaced on the stack by the node value
+        vDepth = vDepth + 1U - node.childCount;
+        if (vDepth > vProgram.stackSize) {
+            vProgram.stackSize = vDepth;
+        }
+        vProgram.code.push_back(ins);
+        if (vState != nullptr && node.childCount != 0U) {
+            if (vState->refsCount[vNode] > 1U) {
+                const auto temp      = static_cast<uint32_t>(vProgram.tempsCount++);
+                vState->temps[vNode] = temp + 1U;
+                ins.op               = OpCode::STORE_TEMP;
+                ins.arg              = temp;
+                vProgram.code.push_back(ins);
+            }
+        }
+        return ErrorCode::NONE;
+    }
+
+    // Evaluate the program block by block, with the columns prepared in m_BatchColumns
+    // the rows are split in chunks evaluated by the threads of the pool, each one with its own stack
+    // the error reported is the one of the first failed chunk, like in a single threaded evaluation
+    ErrorCode m_evalBatch(const size_t vCount, double* vOut, ErrorCode* vRowErrors) {
+        m_clearError();
+        if (m_DefinedVarsDirty) {
+            m_loadDefinedVars();
+        }
+        if (m_Program.functionsRevision != m_FunctionsRevision && m_compile() != ErrorCode::NONE) {
+            return m_Error.code;  // the functions called or folded by the program may have changed
+        }
+        const size_t threadsCount = getThreadsCount();
+        const size_t tasksCount   = (vCount + s_BatchChunkSize - 1U) / s_BatchChunkSize;
+        m_BatchStacks.resize(threadsCount);
+        for (auto& stack : m_BatchStacks) {
+            stack.resize((m_Program.stackSize + m_Program.tempsCount) * s_BatchBlockSize);
+        }
+        if (threadsCount == 1U || tasksCount < 2U) {
+            return m_evalRows(m_Program, m_BatchColumns.data(), m_VarSources.data(), 0U, vCount, vOut, m_BatchStacks[0].data(), vRowErrors, m_Error);
+        }
+        m_BatchErrors.resize(threadsCount);
+        for (auto& error : m_BatchErrors) {
+            error.first = tasksCount;
+        }
+        const size_t errorTask = m_ThreadPool->run(tasksCount, [this, vCount, vOut, vRowErrors](size_t vTask, size_t vWorker) {
+            const size_t row = vTask * s_BatchChunkSize;
+            auto& error      = m_BatchErrors[vWorker];
+            if (m_evalRows(m_Program, m_BatchColumns.data(), m_VarSources.data(), row, ::std::min(vCount, row + s_BatchChunkSize), vOut, m_BatchStacks[vWorker].data(), vRowErrors, error.second) != ErrorCode::NONE) {
+                error.first = vTask;  // a thread stops at its first failed task
+                return false;
+            }
+            return true;
+        });
+        for (const auto& error : m_BatchErrors) {
+            if (errorTask < tasksCount && error.first == errorTask) {
+                m_Error = error.second;
+            }
+        }
+        return m_Error.code;
+    }
+
+    // Evaluate the rows [vBegin, vEnd) of a program block by block, the sticky flags being checked at the end
+    // the stack must be able to contain (vProgram.stackSize + vProgram.tempsCount) blocks
+    // if vRowErrors is not nullptr, the error of each row is written in it, only the errors not related to a row being returned
+    static ErrorCode m_evalRows(const Program& vProgram, const double* const* vColumns, const double* const* vSources, const size_t vBegin, const size_t vEnd, double* vOut, double* vStack, ErrorCode* vRowErrors, ExprError& vError) {
+        uint32_t flags = 0U;
+        for (size_t row = vBegin; row < vEnd; row += s_BatchBlockSize) {
+            const size_t count  = (vEnd - row < s_BatchBlockSize) ? vEnd - row : s_BatchBlockSize;
+            ErrorCode* rowErrors = nullptr;
+            if (vRowErrors != nullptr) {
+                rowErrors = vRowErrors + row;
+                ::std::fill(rowErrors, rowErrors + count, ErrorCode::NONE);
+            }
+            const ErrorCode code = m_runBlock(vProgram, vColumns, vSources, row, count, vStack, flags, rowErrors, vError);
+            if (code != ErrorCode::NONE) {
+                return code;
+            }
+            ::std::memcpy(vOut + row, vStack, count * sizeof(double));
+        }
+        return vRowErrors == nullptr ? m_getFlagsError(flags, vError) : ErrorCode::NONE;
+    }
+
+    // Check the values of a block for NaN or Inf, returns the error of the first bad value
+    static ErrorCode m_checkBlock(const double* vValues, const size_t vCount, ExprError& vError) {
+        for (size_t idx = 0; idx < vCount; ++idx) {
+            const ErrorCode code = m_checkValue(vValues[idx], vError);
+            if (code != ErrorCode::NONE) {
+                return code;
+            }
+        }
+        return ErrorCode::NONE;
+    }
+
+    // Returns the flags of the NaN or Inf values of a block
+    static uint32_t m_getBlockFlags(const double* vValues, const size_t vCount) {
+        uint32_t flags = 0U;
+        for (size_t idx = 0; idx < vCount; ++idx) {
+            flags |= m_getValueFlags(vValues[idx]);
+        }
+        return flags;
+    }
+
+    // Execute a compiled program over vCount rows starting at vRow, each value of the stack being a block of s_BatchBlockSize values
+    // vColumns gives for each slot the values of the variable per row, or nullptr for using the single value of vSources
+    // the errors are accumulated in vFlags with ErrorCheckPolicy::STICKY_FLAGS
+    // if vRowErrors is not nullptr, the errors of the rows are written in it and don't stop the evaluation
+    static ErrorCode m_runBlock(const Program& vProgram, const double* const* vColumns, const double* const* vSources, const size_t vRow, const size_t vCount, double* vStack, uint32_t& vFlags, ErrorCode* vRowErrors, ExprError& vError) {
+        const size_t bs                  = s_BatchBlockSize;
+        const bool isEveryNode           = (vProgram.errorCheck == ErrorCheckPolicy::EVERY_NODE);
+        const bool isSticky              = (vProgram.errorCheck == ErrorCheckPolicy::STICKY_FLAGS);
+        const double* constants          = vProgram.constants.data();
+        const ProgramFunction* functions = vProgram.functions.data();
+        const simd::Kernels& kernels     = *vProgram.kernels;
+        double* sp                       = vStack;  // next free block of the stack
+        double* temps                    = vStack + vProgram.stackSize * bs;
+        for (const auto& ins : vProgram.code) {
+            switch (ins.op) {
+                case OpCode::PUSH_NUMBER: {
+                    ::std::fill(sp, sp + vCount, constants[ins.arg]);
+                    sp += bs;
+                } break;
+                case OpCode::PUSH_VARIABLE: {
+                    const double* column = vColumns[ins.arg];
+                    if (column != nullptr) {
+                        ::std::memcpy(sp, column + vRow, vCount * sizeof(double));
+                    } else {
+                        const double* source = vSources[ins.arg];
+                        if (source == nullptr) {
+                            return m_fail(vError, ErrorCode::VARIABLE_NOT_FOUND, "Variable not found: " + vProgram.variables[ins.arg]);
+                        }
+                        ::std::fill(sp, sp + vCount, *source);
+                    }
+                    sp += bs;
+                } break;
+                case OpCode::ADD: {
+                    sp -= bs;
+                    kernels.add(sp - bs, sp, vCount);
+                } break;
+                case OpCode::SUB: {
+                    sp -= bs;
+                    kernels.sub(sp - bs, sp, vCount);
+                } break;
+                case OpCode::MUL: {
+                    sp -= bs;
+                    kernels.mul(sp - bs, sp, vCount);
+                } break;
+                case OpCode::DIV: {
+                    sp -= bs;
+                    if ((isEveryNode || isSticky) && kernels.hasZero(sp, vCount)) {
+                        if (vRowErrors != nullptr) {
+                            m_setRowsError(vRowErrors, sp, vCount, ErrorCode::DIVISION_BY_ZERO, isSticky, [](double v) { return v == 0.0; });
+                        } else if (isEveryNode) {
+                            return m_fail(vError, ErrorCode::DIVISION_BY_ZERO, "Division by zero");
+                        }
+                        vFlags |= s_DivisionByZeroFlag;
+                    }
+                    kernels.div(sp - bs, sp, vCount);
+                } break;
+                case OpCode::POW: {
+                    sp -= bs;
+                    double* a = sp - bs;
+                    for (size_t idx = 0; (isEveryNode || isSticky) && idx < vCount; ++idx) {
+                        if (a[idx] < 0.0) {
+                            if (vRowErrors != nullptr) {
+                                m_setRowsError(vRowErrors, a, vCount, ErrorCode::EVALUATION_NAN, isSticky, [](double v) { return v < 0.0; });
+                            } else if (isEveryNode) {
+                                return m_fail(vError, ErrorCode::EVALUATION_NAN, "Pow base value is negative");
+                            }
+                            vFlags |= s_NegativePowFlag;
+                            break;
+                        }
+                    }
+                    if (kernels.pow != nullptr) {
+                        kernels.pow(a, sp, vCount);
+                    } else {
+                        for (size_t idx = 0; idx < vCount; ++idx) {
+                            a[idx] = ::std::pow(a[idx], sp[idx]);
+                        }
+                    }
+                } break;
+                case OpCode::MOD: {
+                    sp -= bs;
+                    double* a = sp - bs;
+                    if ((isEveryNode || isSticky) && kernels.hasZero(sp, vCount)) {
+                        if (vRowErrors != nullptr) {
+                            m_setRowsError(vRowErrors, sp, vCount, ErrorCode::DIVISION_BY_ZERO, isSticky, [](double v) { return v == 0.0; });
+                        } else if (isEveryNode) {
+                            return m_fail(vError, ErrorCode::DIVISION_BY_ZERO, "Division by zero");
+                        }
+                        vFlags |= s_DivisionByZeroFlag;
+                    }
+                    for (size_t idx = 0; idx < vCount; ++idx) {
+                        a[idx] = ::std::fmod(a[idx], sp[idx]);
+                    }
+                } break;
+                case OpCode::NEG: {
+                    kernels.neg(sp - bs, vCount);
+                } break;
+                case OpCode::POWI: {
+                    double* a = sp - bs;
+                    for (size_t idx = 0; (isEveryNode || isSticky) && idx < vCount; ++idx) {
+                        if (a[idx] < 0.0) {
+                            if (vRowErrors != nullptr) {
+                                m_setRowsError(vRowErrors, a, vCount, ErrorCode::EVALUATION_NAN, isSticky, [](double v) { return v < 0.0; });
+                            } else if (isEveryNode) {
+                                return m_fail(vError, ErrorCode::EVALUATION_NAN, "Pow base value is negative");
+                            }
+                            vFlags |= s_NegativePowFlag;
+                            break;
+                        }
+                    }
+                    for (size_t idx = 0; idx < vCount; ++idx) {
+                        a[idx] = m_PowInt(a[idx], static_cast<int32_t>(ins.arg));
+                    }
+                } break;
+                case OpCode::SQRT: {
+                    kernels.sqrt(sp - bs, vCount);
+                } break;
+                case OpCode::STORE_TEMP: {
+                    ::std::memcpy(temps + ins.arg * bs, sp - bs, vCount * sizeof(double));
+                } break;
+                case OpCode::LOAD_TEMP: {
+                    ::std::memcpy(sp, temps + ins.arg * bs, vCount * sizeof(double));
+                    sp += bs;
+                } break;
+                case OpCode::CALL_UNARY: {
+                    const auto& fun = functions[ins.arg];
+                    double* a       = sp - bs;
+                    if (fun.unaryKernel != nullptr) {
+                        fun.unaryKernel(a, vCount);
+                    } else {
+                        for (size_t idx = 0; idx < vCount; ++idx) {
+                            a[idx] = fun.function->unaryFunctor(a[idx]);
+                        }
+                    }
+                } break;
+                case OpCode::CALL_BINARY: {
+                    const auto& fun = functions[ins.arg];
+                    sp -= bs;
+                    double* a = sp - bs;
+                    if (fun.binaryKernel != nullptr) {
+                        fun.binaryKernel(a, sp, vCount);
+                    } else {
+                        for (size_t idx = 0; idx < vCount; ++idx) {
+                            a[idx] = fun.function->binaryFunctor(a[idx], sp[idx]);
+                        }
+                    }
+                } break;
+                case OpCode::CALL_TERNARY: {
+                    const auto& fun = functions[ins.arg];
+                    sp -= 2 * bs;
+                    double* a = sp - bs;
+                    if (fun.ternaryKernel != nullptr) {
+                        fun.ternaryKernel(a, sp, sp + bs, vCount);
+                    } else {
+                        for (size_t idx = 0; idx < vCount; ++idx) {
+                            a[idx] = fun.function->ternaryFunctor(a[idx], sp[idx], sp[bs + idx]);
+                        }
+                    }
+                } break;
+                case OpCode::FACTORIAL: {
+                    double* a = sp - bs;
+                    for (size_t idx = 0; idx < vCount; ++idx) {
+                        if (isEveryNode && !m_isFactorialDefined(a[idx])) {
+                            if (vRowErrors == nullptr) {
+                                return m_fail(vError, ErrorCode::PARSE_ERROR, "Factorial is not defined for negative or non-integer values.");
+                            }
+                            m_setRowError(vRowErrors[idx], ErrorCode::PARSE_ERROR, false);
+                        }
+                        a[idx] = m_Factorial(a[idx]);
+                    }
+                } break;
+                default: return m_fail(vError, ErrorCode::UNKNOWN_NODE_TYPE, "Unknown instruction");
+            }
+            if ((isEveryNode || isSticky) && kernels.hasNanOrInf(sp - bs, vCount)) {
+                if (vRowErrors != nullptr) {
+                    m_setRowsValueError(vRowErrors, sp - bs, vCount, isSticky);
+                } else if (isEveryNode) {
+                    return m_checkBlock(sp - bs, vCount, vError);  // find the error of the first bad value
+                }
+                vFlags |= m_getBlockFlags(sp - bs, vCount);
+            }
+        }
+        if (vProgram.errorCheck == ErrorCheckPolicy::FINAL_RESULT && kernels.hasNanOrInf(vStack, vCount)) {
+            if (vRowErrors == nullptr) {
+                return m_checkBlock(vStack, vCount, vError);
+            }
+            m_setRowsValueError(vRowErrors, vStack, vCount, false);
+        }
+        return ErrorCode::NONE;
+    }
+
+    // Set the error of a row, the first one being kept, or the most important one with ErrorCheckPolicy::STICKY_FLAGS
+    // so the error of a row is the one reported by its evaluation with eval
+    static void m_setRowError(ErrorCode& vRowError, const ErrorCode vCode, const bool vIsSticky) {
+        if (vRowError == ErrorCode::NONE || (vIsSticky && m_getErrorRank(vCode) > m_getErrorRank(vRowError))) {
+            vRowError = vCode;
+        }
+    }
+
+    // Set the error vCode to the rows whose value is matching vIsError
+    template <typename TPredicate>
+    static void m_setRowsError(ErrorCode* vRowErrors, const double* vValues, const size_t vCount, const ErrorCode vCode, const bool vIsSticky, TPredicate vIsError) {
+        for (size_t idx = 0; idx < vCount; ++idx) {
+            if (vIsError(vValues[idx])) {
+                m_setRowError(vRowErrors[idx], vCode, vIsSticky);
+            }
+        }
+    }
+
+    // Set the error of the rows whose value is NaN or Inf
+    static void m_setRowsValueError(ErrorCode* vRowErrors, const double* vValues, const size_t vCount, const bool vIsSticky) {
+        for (size_t idx = 0; idx < vCount; ++idx) {
+            if (::std::isnan(vValues[idx])) {
+                m_setRowError(vRowErrors[idx], ErrorCode::EVALUATION_NAN, vIsSticky);
+            } else if (::std::isinf(vValues[idx])) {
+                m_setRowError(vRowErrors[idx], ErrorCode::EVALUATION_INF, vIsSticky);
+            }
+        }
+    }
+
+    // Returns the rank of an error in the accumulated flags, the division by zero first, like in m_getFlagsError
+    static int m_getErrorRank(const ErrorCode vCode) {
+        switch (vCode) {
+            case ErrorCode::DIVISION_BY_ZERO: return 3;
+            case ErrorCode::EVALUATION_NAN: return 2;
+            case ErrorCode::EVALUATION_INF: return 1;
+            default: return 0;
+        }
+    }
+
+    // Execute a compiled program with the error checks of its policy, the stack must be able to contain vProgram.stackSize values
+    // vResult is set only if the evaluation succeeded
+    static ErrorCode m_run(const Program& vProgram, const double* const* vSources, double* vStack, double& vResult, ExprError& vError, const bool vVerbose = false) {
+        switch (vProgram.errorCheck) {
+            case ErrorCheckPolicy::FINAL_RESULT: return vVerbose ? m_runChecked<ErrorCheckPolicy::FINAL_RESULT, true>(vProgram, vSources, vStack, vResult, vError) : m_runChecked<ErrorCheckPolicy::FINAL_RESULT, false>(vProgram, vSources, vStack, vResult, vError);
+            case ErrorCheckPolicy::STICKY_FLAGS: return vVerbose ? m_runChecked<ErrorCheckPolicy::STICKY_FLAGS, true>(vProgram, vSources, vStack, vResult, vError) : m_runChecked<ErrorCheckPolicy::STICKY_FLAGS, false>(vProgram, vSources, vStack, vResult, vError);
+            case ErrorCheckPolicy::NONE: return vVerbose ? m_runChecked<ErrorCheckPolicy::NONE, true>(vProgram, vSources, vStack, vResult, vError) : m_runChecked<ErrorCheckPolicy::NONE, false>(vProgram, vSources, vStack, vResult, vError);
+            default: return vVerbose ? m_runChecked<ErrorCheckPolicy::EVERY_NODE, true>(vProgram, vSources, vStack, vResult, vError) : m_runChecked<ErrorCheckPolicy::EVERY_NODE, false>(vProgram, vSources, vStack, vResult, vError);
+        }
+    }
+
+    // Execute a compiled program, the checks being chosen at compile time so the other ones cost nothing
+    template <ErrorCheckPolicy tPolicy, bool tVerbose>
+    static ErrorCode m_runChecked(const Program& vProgram, const double* const* vSources, double* vStack, double& vResult, ExprError& vError) {
+        const double* constants          = vProgram.constants.data();
+        const ProgramFunction* functions = vProgram.functions.data();
+        double* sp                       = vStack;  // next free slot of the stack
+        double* temps                    = vStack + vProgram.stackSize;
+        uint32_t flags                   = 0U;  // errors accumulated with ErrorCheckPolicy::STICKY_FLAGS
+        for (const auto& ins : vProgram.code) {
+            switch (ins.op) {
+                case OpCode::PUSH_NUMBER: {
+                    *sp++ = constants[ins.arg];
+                } break;
+                case OpCode::PUSH_VARIABLE: {
+                    const double* source = vSources[ins.arg];
+                    if (source == nullptr) {
+                        return m_fail(vError, ErrorCode::VARIABLE_NOT_FOUND, "Variable not found: " + vProgram.variables[ins.arg]);
+                    }
+                    *sp++ = *source;
+                } break;
+                case OpCode::ADD: {
+                    --sp;
+                    sp[-1] = sp[-1] + sp[0];
+                } break;
+                case OpCode::SUB: {
+                    --sp;
+                    sp[-1] = sp[-1] - sp[0];
+                } break;
+                case OpCode::MUL: {
+                    --sp;
+                    sp[-1] = sp[-1] * sp[0];
+                } break;
+                case OpCode::DIV: {
+                    --sp;
+                    if (tPolicy == ErrorCheckPolicy::EVERY_NODE && sp[0] == 0.0) {
+                        return m_fail(vError, ErrorCode::DIVISION_BY_ZERO, "Division by zero");
+                    } else if (tPolicy == ErrorCheckPolicy::STICKY_FLAGS && sp[0] == 0.0) {
+                        flags |= s_DivisionByZeroFlag;
+                    }
+                    sp[-1] = sp[-1] / sp[0];
+                } break;
+                case OpCode::POW: {
+                    --sp;
+                    if (tPolicy == ErrorCheckPolicy::EVERY_NODE && sp[-1] < 0.0) {
+                        return m_fail(vError, ErrorCode::EVALUATION_NAN, "Pow base value is negative");
+                    } else if (tPolicy == ErrorCheckPolicy::STICKY_FLAGS && sp[-1] < 0.0) {
+                        flags |= s_NegativePowFlag;
+                    }
+                    sp[-1] = ::std::pow(sp[-1], sp[0]);
+                } break;
+                case OpCode::MOD: {
+                    --sp;
+                    if (tPolicy == ErrorCheckPolicy::EVERY_NODE && sp[0] == 0.0) {
+                        return m_fail(vError, ErrorCode::DIVISION_BY_ZERO, "Division by zero");
+                    } else if (tPolicy == ErrorCheckPolicy::STICKY_FLAGS && sp[0] == 0.0) {
+                        flags |= s_DivisionByZeroFlag;
+                    }
+                    sp[-1] = ::std::fmod(sp[-1], sp[0]);
+                } break;
+                case OpCode::NEG: {
+                    sp[-1] = -sp[-1];
+                } break;
+                case OpCode::POWI: {
+                    if (tPolicy == ErrorCheckPolicy::EVERY_NODE && sp[-1] < 0.0) {
+                        return m_fail(vError, ErrorCode::EVALUATION_NAN, "Pow base value is negative");
+                    } else if (tPolicy == ErrorCheckPolicy::STICKY_FLAGS && sp[-1] < 0.0) {
+                        flags |= s_NegativePowFlag;
+                    }
+                    sp[-1] = m_PowInt(sp[-1], static_cast<int32_t>(ins.arg));
+                } break;
+                case OpCode::SQRT: {
+                    sp[-1] = ::std::sqrt(sp[-1]);
+                } break;
+                case OpCode::STORE_TEMP: {
+                    temps[ins.arg] = sp[-1];
+                } break;
+                case OpCode::LOAD_TEMP: {
+                    *sp++ = temps[ins.arg];
+                } break;
+                case OpCode::CALL_UNARY: {
+                    sp[-1] = functions[ins.arg].function->unaryFunctor(sp[-1]);
+                } break;
+                case OpCode::CALL_BINARY: {
+                    --sp;
+                    sp[-1] = functions[ins.arg].function->binaryFunctor(sp[-1], sp[0]);
+                } break;
+                case OpCode::CALL_TERNARY: {
+                    sp -= 2;
+                    sp[-1] = functions[ins.arg].function->ternaryFunctor(sp[-1], sp[0], sp[1]);
+                } break;
+                case OpCode::FACTORIAL: {
+                    if (tPolicy == ErrorCheckPolicy::EVERY_NODE && !m_isFactorialDefined(sp[-1])) {
+                        return m_fail(vError, ErrorCode::PARSE_ERROR, "Factorial is not defined for negative or non-integer values.");
+                    }
+                    sp[-1] = m_Factorial(sp[-1]);
+                } break;
+                default: return m_fail(vError, ErrorCode::UNKNOWN_NODE_TYPE, "Unknown instruction");
+            }
+
+            // Check of the result for NaN or Inf
+            if (tPolicy == ErrorCheckPolicy::EVERY_NODE && m_checkValue(sp[-1], vError) != ErrorCode::NONE) {
+                return vError.code;
+            } else if (tPolicy == ErrorCheckPolicy::STICKY_FLAGS && !::std::isfinite(sp[-1])) {
+                flags |= m_getValueFlags(sp[-1]);
+            }
+
+            if (tVerbose) {
+                ::std::cout << "Evaluating Node: " << String::fromDouble(sp[-1]).c_str() << "\n";
+            }
+        }
+        if (tPolicy == ErrorCheckPolicy::FINAL_RESULT && m_checkValue(vStack[0], vError) != ErrorCode::NONE) {
+            return vError.code;
+        } else if (tPolicy == ErrorCheckPolicy::STICKY_FLAGS && flags != 0U) {
+            return m_getFlagsError(flags, vError);
+        }
+        vResult = vStack[0];
+        return ErrorCode::NONE;
+    }
+
+    // Check a value for NaN or Inf
+    static ErrorCode m_checkValue(const double vValue, ExprError& vError) {
+        if (::std::isnan(vValue)) {
+            return m_fail(vError, ErrorCode::EVALUATION_NAN, "Result is NaN");
+        } else if (::std::isinf(vValue)) {
+            return m_fail(vError, ErrorCode::EVALUATION_INF, "Result is Inf");
+        }
+        return ErrorCode::NONE;
+    }
+
+    // Returns the flags of a NaN or an Inf value
+    static uint32_t m_getValueFlags(const double vValue) {
+        return (::std::isnan(vValue) ? s_NanFlag : 0U) | (::std::isinf(vValue) ? s_InfFlag : 0U);
+    }
+
+    // Returns the error of the accumulated flags, the division by zero first, like the causes before their effects
+    static ErrorCode m_getFlagsError(const uint32_t vFlags, ExprError& vError) {
+        if ((vFlags & s_DivisionByZeroFlag) != 0U) {
+            return m_fail(vError, ErrorCode::DIVISION_BY_ZERO, "Division by zero");
+        } else if ((vFlags & s_NegativePowFlag) != 0U) {
+            return m_fail(vError, ErrorCode::EVALUATION_NAN, "Pow base value is negative");
+        } else if ((vFlags & s_NanFlag) != 0U) {
+            return m_fail(vError, ErrorCode::EVALUATION_NAN, "Result is NaN");
+        } else if ((vFlags & s_InfFlag) != 0U) {
+            return m_fail(vError, ErrorCode::EVALUATION_INF, "Result is Inf");
+        }
+        return ErrorCode::NONE;
+    }
+
+    // Tokenize and parse the expression in vTree
+    ErrorCode m_parseTree(SyntaxTree& vTree) {
+        m_tokenize(m_Expr.c_str(), m_Tokens);
+        const auto& tokens = m_Tokens;
+        size_t pos         = 0;
+        vTree.nodes.clear();
+        vTree.nodes.reserve(tokens.size());  // at most one node per token, so the nodes are allocated once
+        ErrorCode code = m_parseExpression(tokens, pos, 0, vTree, vTree.root);  // Parse the expression to create the syntax tree
+
+        // Check for remaining tokens after parsing
+        if (code == ErrorCode::NONE && pos < tokens.size()) {
+            // If the next token is an unmatched closing parenthesis
+            if (tokens[pos].type == TokenType::RPAREN) {
+                code = m_fail(m_Error, ErrorCode::UNMATCHED_PARENTHESIS, "Unmatched parenthesis found at the end of the expression.");
+            } else {
+                // If other tokens remain, which is also abnormal
+                code = m_fail(m_Error, ErrorCode::PARSE_ERROR, "Unexpected token found after complete parsing.");
+            }
+        }
+        return code;
+    }
+
+    // Parse an expression to add its nodes in the syntax tree, vNode being the index of its root
+    ErrorCode m_parseExpression(const ::std::vector<Token>& tokens, size_t& pos, int precedence, SyntaxTree& vTree, uint32_t& vNode) {
+        if (pos >= tokens.size()) {
+            return m_fail(m_Error, ErrorCode::PARSE_ERROR, "Unexpected end of expression");
+        }
+        uint32_t node  = 0U;
+        ErrorCode code = m_parseFactor(tokens, pos, vTree, node);
+        if (code != ErrorCode::NONE) {
+            return code;
+        }
+        while (pos < tokens.size()) {
+            const Token& token = tokens[pos];
+            int opPrecedence   = 0;
+            if (token.type == TokenType::OPERATOR) {
+                if (token.op == OpCode::FACTORIAL) {  // a factor takes only one postfix "!"
+                    return m_fail(m_Error, ErrorCode::PARSE_ERROR, "Factorial operator '!' cannot follow another factorial, use parenthesis: (x!)!");
+                }
+                opPrecedence = m_getPrecedence(token.op);
+                if (opPrecedence == 0) {
+                    return m_fail(m_Error, ErrorCode::OPERATOR_NOT_FOUND, "Operator not found: " + m_getTokenText(token));
+                }
+            }
+            if (opPrecedence <= precedence) {
+                break;
+            }
+            const OpCode op = token.op;
+            ++pos;
+            if (pos >= tokens.size()) {
+                return m_fail(m_Error, ErrorCode::PARSE_ERROR, "Incomplete expression after operator: " + m_getTokenText(tokens[pos - 1]));
+            }
+            uint32_t rightNode = 0U;
+            code               = m_parseExpression(tokens, pos, opPrecedence, vTree, rightNode);
+            if (code != ErrorCode::NONE) {
+                return code;
+            }
+            Node opNode;
+            opNode.type       = NodeType::OPERATOR;
+            opNode.op         = op;
+            opNode.childCount = 2;
+            opNode.childs[0]  = node;
+            opNode.childs[1]  = rightNode;
+            node              = vTree.add(::std::move(opNode));
+        }
+        vNode = node;
+        return ErrorCode::NONE;
+    }
+
+    // Apply the postfix operator "!" to a node if it follows it, vNode becoming the index of the operator
+    static void m_parsePostfix(const ::std::vector<Token>& tokens, size_t& pos, SyntaxTree& vTree, uint32_t& vNode) {
+        if (pos < tokens.size() && tokens[pos].type == TokenType::OPERATOR && tokens[pos].op == OpCode::FACTORIAL) {
+            Node opNode;
+            opNode.type       = NodeType::OPERATOR;
+            opNode.op         = OpCode::FACTORIAL;
+            opNode.childs[0]  = vNode;
+            opNode.childCount = 1;
+            vNode             = vTree.add(::std::move(opNode));
+            ++pos;
+        }
+    }
+
+    // Parse a factor in an expression (number, variable, parenthesis, function), vNode being the index of its root
+    ErrorCode m_parseFactor(const ::std::vector<Token>& tokens, size_t& pos, SyntaxTree& vTree, uint32_t& vNode) {
+        Node node;
+        ErrorCode code = ErrorCode::NONE;
+        if (pos >= tokens.size()) {
+            return m_fail(m_Error, ErrorCode::PARSE_ERROR, "Unexpected end of expression");
+        }
+
+        if (tokens[pos].type == TokenType::NUMBER) {
+            if (tokens[pos].length == 1U && m_Expr[tokens[pos].offset] == '.') {
+                return m_fail(m_Error, ErrorCode::PARSE_ERROR, "Invalid number: .");  // a point alone
+            }
+            node.type  = NodeType::NUMBER;
+            node.value = tokens[pos].value;
+            ++pos;
+
+            // Gestion de l'op�rateur postfix� "!" pour les nombres
+            if (pos < tokens.size() && tokens[pos].type == TokenType::OPERATOR && tokens[pos].op == OpCode::FACTORIAL) {
+                Node opNode;
+                opNode.type       = NodeType::OPERATOR;
+                opNode.op         = OpCode::FACTORIAL;
+                opNode.childs[0]  = vTree.add(::std::move(node));
+                opNode.childCount = 1;
+                node              = opNode;  // Remplacer le n�ud par l'op�rateur postfix�
+                ++pos;
+            }
+        } else if (tokens[pos].type == TokenType::VARIABLE) {
+            const String identifier = m_getTokenText(tokens[pos]);
+            ++pos;
+
+            if (pos < tokens.size() && tokens[pos].type == TokenType::LPAREN) {
+                auto it = m_Functions.find(identifier);
+                if (it == m_Functions.end()) {
+                    return m_fail(m_Error, ErrorCode::FUNCTION_NOT_FOUND, "Function not found: " + identifier);
+                }
+
+                ++pos;  // Passer la parenth�se ouvrante
+
+                if (pos < tokens.size() && tokens[pos].type == TokenType::RPAREN) {
+                    return m_fail(m_Error, ErrorCode::FUNCTION_WRONG_ARGUMENTS_COUNT, "Function called with incorrect number of arguments: " + identifier);
+                }
+
+                node.type = NodeType::FUNCTION;
+                node.name = identifier;
+                for (;;) {
+                    uint32_t child = 0U;
+                    code           = m_parseExpression(tokens, pos, 0, vTree, child);
+                    if (code != ErrorCode::NONE) {
+                        return code;
+                    }
+                    node.childs[node.childCount++] = child;
+                    if (pos >= tokens.size() || tokens[pos].type != TokenType::SEPARATOR) {
+                        break;
+                    }
+                    ++pos;
+                    if (node.childCount >= 3) {
+                        return m_fail(m_Error, ErrorCode::PARSE_ERROR, "Too many arguments provided for function: " + identifier);
+                    }
+                }
+
+                if (pos >= tokens.size() || tokens[pos].type != TokenType::RPAREN) {
+                    return m_fail(m_Error, ErrorCode::UNMATCHED_PARENTHESIS, "Unmatched parenthesis");
+                }
+                ++pos;
+
+                if (node.childCount != it->second.argCount) {
+                    return m_fail(m_Error, ErrorCode::FUNCTION_WRONG_ARGUMENTS_COUNT, "Incorrect number of arguments for function: " + identifier);
+                }
+                vNode = vTree.add(::std::move(node));
+                m_parsePostfix(tokens, pos, vTree, vNode);
+                return ErrorCode::NONE;
+
+            } else {
+                // Gestion des variables (non-fonctions et non-constantes)
+                auto it = m_Constant.find(identifier);
+                if (it != m_Constant.end()) {
+                    node.type  = NodeType::NUMBER;
+                    node.value = it->second;
+                } else {
+                    node.type = NodeType::VARIABLE;
+                    node.name = identifier;
+                }
+
+                // Gestion de l'op�rateur postfix� "!" pour les variables
+                if (pos < tokens.size() && tokens[pos].type == TokenType::OPERATOR && tokens[pos].op == OpCode::FACTORIAL) {
+                    Node opNode;
+                    opNode.type       = NodeType::OPERATOR;
+                    opNode.op         = OpCode::FACTORIAL;
+                    opNode.childs[0]  = vTree.add(::std::move(node));
+                    opNode.childCount = 1;
+                    node              = opNode;  // Remplacer le n�ud par l'op�rateur postfix�
+                    ++pos;
+                }
+            }
+        } else if (tokens[pos].type == TokenType::LPAREN) {
+            ++pos;
+            if (pos < tokens.size() && tokens[pos].type == TokenType::RPAREN) {
+                return m_fail(m_Error, ErrorCode::EMPTY_PARENTHESIS, "Empty parenthesis found");
+            }
+            code = m_parseExpression(tokens, pos, 0, vTree, vNode);  // no node for the parenthesis
+            if (code != ErrorCode::NONE) {
+                return code;
+            }
+            if (pos >= tokens.size() || tokens[pos].type != TokenType::RPAREN) {
+                return m_fail(m_Error, ErrorCode::UNMATCHED_PARENTHESIS, "Unmatched parenthesis");
+            }
+            ++pos;
+            m_parsePostfix(tokens, pos, vTree, vNode);
+            return ErrorCode::NONE;
+        } else if (tokens[pos].type == TokenType::OPERATOR) {
+            const OpCode op = tokens[pos].op;
+            if (op == OpCode::SUB) {
+                node.type = NodeType::OPERATOR;
+                node.op   = OpCode::NEG;
+                ++pos;
+                node.childCount = 1;
+                code            = m_parseFactor(tokens, pos, vTree, node.childs[0]);
+                if (code != ErrorCode::NONE) {
+                    return code;
+                }
+            } else if (op == OpCode::FACTORIAL) {
+                return m_fail(m_Error, ErrorCode::PARSE_ERROR, "Factorial operator '!' cannot be used alone or in prefix position.");
+            } else {
+                return m_fail(m_Error, ErrorCode::PARSE_ERROR, "Unexpected operator: " + m_getTokenText(tokens[pos]));
+            }
+        } else {
+            return m_fail(m_Error, ErrorCode::PARSE_ERROR, "Unexpected token: " + m_getTokenText(tokens[pos]));
+        }
+
+        vNode = vTree.add(::std::move(node));
+        return ErrorCode::NONE;
+    }
+
+    /////////////////////////////////////////
+    //// C++ SOURCE /////////////////////////
+    /////////////////////////////////////////
+
+    // Returns the C++ literal of a number, keeping all its bits
+    static ::std::string m_getCppNumber(const double vValue) {
+        if (::std::isnan(vValue)) {
+            return "::std::numeric_limits<double>::quiet_NaN()";
+        } else if (::std::isinf(vValue)) {
+            return vValue < 0.0 ? "(-::std::numeric_limits<double>::infinity())" : "::std::numeric_limits<double>::infinity()";
+        }
+        ::std::stringstream str;
+        str.precision(17);  // enough digits to read back the same double
+        str << vValue;
+        ::std::string literal = str.str();
+        if (literal.find_first_of(".e") == ::std::string::npos) {
+            literal += ".0";
+        }
+        return ::std::signbit(vValue) ? "(" + literal + ")" : literal;
+    }
+
+    // Returns the C++ name of a variable, with a '_' appended if it is a C++ keyword or a macro of the standard headers
+    // the names of the variables have only letters and digits, so this name can't be the one of another variable
+    static ::std::string m_getCppName(const String& vName) {
+        static const char* s_Reserved[] = {"alignas", "alignof", "and", "asm", "auto", "bitand", "bitor", "bool", "break", "case", "catch", "char",
+                                           "compl", "concept", "const", "consteval", "constexpr", "constinit", "continue", "decltype", "default",
+                                           "delete", "do", "double", "else", "enum", "explicit", "export", "extern", "false", "float", "for",
+                                           "friend", "goto", "if", "import", "inline", "int", "long", "module", "mutable", "namespace", "new",
+                                           "noexcept", "not", "nullptr", "operator", "or", "private", "protected", "public", "register",
+                                           "requires", "return", "short", "signed", "sizeof", "static", "struct", "switch", "template", "this",
+                                           "throw", "true", "try", "typedef", "typeid", "typename", "union", "unsigned", "using", "virtual",
+                                           "void", "volatile", "while", "xor", "NULL", "NAN", "INFINITY", "errno", "linux", "unix"};
+        for (const auto& reserved : s_Reserved) {
+            if (vName == reserved) {
+                return vName.to_string() + "_";
+            }
+        }
+        return vName.to_string();
+    }
+
+    // Replace all the occurrences of a pattern in a string
+    static void m_replaceAll(::std::string& vStr, const ::std::string& vPattern, const ::std::string& vReplacement) {
+        for (size_t pos = vStr.find(vPattern); pos != ::std::string::npos; pos = vStr.find(vPattern, pos + vReplacement.size())) {
+            vStr.replace(pos, vPattern.size(), vReplacement);
+        }
+    }
+
+    // Get the C++ source of an instruction consuming values of the stack, $0 to $2 being its arguments
+    // the source is an expression, or statements (one by line) declaring its result $r
+    void m_getCppOperation(const Instruction& vIns, ::std::string& vCode, size_t& vArgCount) const {
+        vArgCount = 2U;
+        switch (vIns.op) {
+            case OpCode::ADD: vCode = "$0 + $1"; break;
+            case OpCode::SUB: vCode = "$0 - $1"; break;
+            case OpCode::MUL: vCode = "$0 * $1"; break;
+            case OpCode::DIV: vCode = "$0 / $1"; break;
+            case OpCode::POW: vCode = "::std::pow($0, $1)"; break;
+            case OpCode::MOD: vCode = "::std::fmod($0, $1)"; break;
+            case OpCode::NEG: {
+                vArgCount = 1U;
+                vCode     = "-$0";
+            } break;
+            case OpCode::POWI: {
+                // the chain of multiplications of m_PowInt
+                vArgCount            = 1U;
+                const auto exponent  = static_cast<int32_t>(vIns.arg);
+                uint32_t n           = static_cast<uint32_t>(exponent < 0 ? -exponent : exponent);
+                vCode                = "double $r = 1.0;\ndouble $r_x = $0;";
+                while (n != 0U) {
+                    if (n & 1U) {
+                        vCode += "\n$r *= $r_x;";
+                    }
+                    n >>= 1U;
+                    if (n != 0U) {
+                        vCode += "\n$r_x *= $r_x;";
+                    }
+                }
+                if (exponent < 0) {
+                    vCode += "\n$r = 1.0 / $r;";
+                }
+            } break;
+            case OpCode::SQRT: {
+                vArgCount = 1U;
+                vCode     = "::std::sqrt($0)";
+            } break;
+            case OpCode::CALL_UNARY:
+            case OpCode::CALL_BINARY:
+            case OpCode::CALL_TERNARY: {
+                const ProgramFunction& fun = m_Program.functions[vIns.arg];
+                vArgCount                  = fun.argCount;
+                vCode                      = m_getCppBuiltin(fun.function->builtin);
+                if (vCode.empty()) {
+                    vCode = fun.name.to_string() + (vArgCount == 1U ? "($0)" : vArgCount == 2U ? "($0, $1)" : "($0, $1, $2)");
+                }
+            } break;
+            case OpCode::FACTORIAL: {
+                vArgCount = 1U;
+                vCode     = m_getCppBuiltin(BuiltinId::FACT);
+            } break;
+            default: m_throwError(ErrorCode::UNKNOWN_NODE_TYPE, "Unknown instruction");
+        }
+    }
+
+    /////////////////////////////////////////
+    //// BUILTINS FUNCTIONS /////////////////
+    /////////////////////////////////////////
+
+    // Calculate a power by an integer exponent with a chain of multiplications
+    static double m_PowInt(double vX, int32_t vN) {
+        const bool isInverse = (vN < 0);
+        uint32_t n           = static_cast<uint32_t>(isInverse ? -vN : vN);
+        double result        = 1.0;
+        while (n != 0U) {
+            if (n & 1U) {
+                result *= vX;
+            }
+            n >>= 1U;
+            if (n != 0U) {
+                vX *= vX;
+            }
+        }
+        return isInverse ? 1.0 / result : result;
+    }
+
+    // Returns true if the factorial is defined for a value
+    static bool m_isFactorialDefined(double vValue) {
+        return vValue >= 0 && ::std::floor(vValue) == vValue;
+    }
+
+    // Calculate a factorial, NaN for the negative or non-integer values
+    static double m_Factorial(double vValue) {
+        if (!m_isFactorialDefined(vValue)) {
+            return ::std::numeric_limits<double>::quiet_NaN();
+        }
+        double result    = 1;
+        const auto count = static_cast<int>(vValue);
+        for (int i = 1; i <= count; ++i) {
+            result *= i;
+        }
+        return result;
+    }
+
+    // https://registry.khronos.org/OpenGL-Refpages/gl4/html/min.xhtml
+    static double m_Min(double vX, double vY) {
+        return vX < vY ? vX : vY;
+    }
+
+    // https://registry.khronos.org/OpenGL-Refpages/gl4/html/max.xhtml
+    static double m_Max(double vX, double vY) {
+        return vX > vY ? vX : vY;
+    }
+
+    // https://www.shadertoy.com/???? : sqrt(v*v+k) with k >= 0
+    static double m_SmoothAbs(double vV, double vK) {
+        return ::std::sqrt(vV * vV + ::std::abs(vK));
+    }
+
+    // https://registry.khronos.org/OpenGL-Refpages/gl4/html/clamp.xhtml
+    // Clamp (glsl), Saturate (hlsl)
+    static double m_Clamp(double vX, double vMinVal, double vMaxVal) {
+        return m_Min(m_Max(vX, vMinVal), vMaxVal);
+    }
+
+    // https://registry.khronos.org/OpenGL-Refpages/gl4/html/smoothstep.xhtml
+    static double m_SmoothStep(double vEdge0, double vEdge1, double vX) {
+        double t = m_Clamp((vX - vEdge0) / (vEdge1 - vEdge0), 0.0, 1.0);
+        return t * t * (3.0 - 2.0 * t);
+    }
+
+    // https://registry.khronos.org/OpenGL-Refpages/gl4/html/mix.xhtml
+    // Mix (glsl), lerp (hlsl)
+    static double m_Mix(double vX, double vY, double vA) {
+        return vX * (1.0 - vA) + vY * vA;
+    }
+
+    // https://registry.khronos.org/OpenGL-Refpages/gl4/html/step.xhtml
+    static double m_Step(double vEdge, double vX) {
+        return vX < vEdge ? 0.0 : 1.0;
+    }
+
+    // https://registry.khronos.org/OpenGL-Refpages/gl4/html/sign.xhtml
+    static double m_Sign(double vX) {
+        return static_cast<double>((vX > 0.0) - (vX < 0.0));
+    }
+
+    // Returns the C++ source of a builtin used by toCppSource, the same definitions than the ones above
+    // $0 to $2 are the arguments, an expression or statements (one by line) declaring the result $r, empty if not a builtin
+    static ::std::string m_getCppBuiltin(BuiltinId vBuiltin) {
+        switch (vBuiltin) {
+            case BuiltinId::ABS: return "::std::abs($0)";
+            case BuiltinId::FLOOR: return "::std::floor($0)";
+            case BuiltinId::CEIL: return "::std::ceil($0)";
+            case BuiltinId::ROUND: return "::std::round($0)";
+            case BuiltinId::FRACT: return "$0 - ::std::floor($0)";
+            case BuiltinId::SIGN: return "static_cast<double>(($0 > 0.0) - ($0 < 0.0))";
+            case BuiltinId::SIN: return "::std::sin($0)";
+            case BuiltinId::COS: return "::std::cos($0)";
+            case BuiltinId::TAN: return "::std::tan($0)";
+            case BuiltinId::ASIN: return "::std::asin($0)";
+            case BuiltinId::ACOS: return "::std::acos($0)";
+            case BuiltinId::ATAN: return "::std::atan($0)";
+            case BuiltinId::SINH: return "::std::sinh($0)";
+            case BuiltinId::COSH: return "::std::cosh($0)";
+            case BuiltinId::TANH: return "::std::tanh($0)";
+            case BuiltinId::ASINH: return "::std::asinh($0)";
+            case BuiltinId::ACOSH: return "::std::acosh($0)";
+            case BuiltinId::ATANH: return "::std::atanh($0)";
+            case BuiltinId::LN:
+            case BuiltinId::LOG: return "::std::log($0)";
+            case BuiltinId::LOG1P: return "::std::log1p($0)";
+            case BuiltinId::LOGB: return "::std::logb($0)";
+            case BuiltinId::LOG2: return "::std::log2($0)";
+            case BuiltinId::LOG10: return "::std::log10($0)";
+            case BuiltinId::SQRT: return "::std::sqrt($0)";
+            case BuiltinId::EXP: return "::std::exp($0)";
+            case BuiltinId::FACT:
+                return "double $r = ::std::numeric_limits<double>::quiet_NaN();\n"
+                       "if ($0 >= 0 && ::std::floor($0) == $0) {\n"
+                       "    $r = 1;\n"
+                       "    for (int $r_i = 1; $r_i <= static_cast<int>($0); ++$r_i) {\n"
+                       "        $r *= $r_i;\n"
+                       "    }\n"
+                       "}";
+            case BuiltinId::SATURATE:
+                return "const double $r_max = $0 > 0.0 ? $0 : 0.0;\n"
+                       "const double $r = $r_max < 1.0 ? $r_max : 1.0;";
+            case BuiltinId::MOD: return "::std::fmod($0, $1)";
+            case BuiltinId::POW: return "$0 < 0.0 ? ::std::numeric_limits<double>::quiet_NaN() : ::std::pow($0, $1)";
+            case BuiltinId::ATAN2: return "::std::atan2($0, $1)";
+            case BuiltinId::MIN: return "$0 < $1 ? $0 : $1";
+            case BuiltinId::MAX: return "$0 > $1 ? $0 : $1";
+            case BuiltinId::STEP: return "$1 < $0 ? 0.0 : 1.0";
+            case BuiltinId::HYPOT: return "::std::hypot($0, $1)";
+            case BuiltinId::SMOOTHABS: return "::std::sqrt($0 * $0 + ::std::abs($1))";
+            case BuiltinId::CLAMP:
+                return "const double $r_max = $0 > $1 ? $0 : $1;\n"
+                       "const double $r = $r_max < $2 ? $r_max : $2;";
+            case BuiltinId::LERP:
+            case BuiltinId::MIX: return "$0 * (1.0 - $2) + $1 * $2";
+            case BuiltinId::SMOOTHSTEP:
+                return "const double $r_t = ($2 - $0) / ($1 - $0);\n"
+                       "const double $r_max = $r_t > 0.0 ? $r_t : 0.0;\n"
+                       "const double $r_c = $r_max < 1.0 ? $r_max : 1.0;\n"
+                       "const double $r = $r_c * $r_c * (3.0 - 2.0 * $r_c);";
+            default: return {};
+        }
+    }
+};
+
+// Immutable program compiled by Expr::compile, with its own copy of the functions called
+// it can be evaluated by several threads at the same time, each one with its own EvalContext
+class CompiledExpr {
+    friend class Expr;
+    friend class EvalContext;
+
+public:
+    CompiledExpr(const CompiledExpr&)            = delete;  // the program points on m_Functions
+    CompiledExpr& operator=(const CompiledExpr&) = delete;
+
+    // Returns the compiled expression
+    const String& getExpr() const {
+        return m_Expr;
+    }
+
+    // Returns the compiled program
+    const Program& getProgram() const {
+        return m_Program;
+    }
+
+    // Method to get the handle of a variable of the expression
+    VarHandle getVarHandle(const String& vName) const {
+        auto it = m_VarSlots.find(vName);
+        if (it == m_VarSlots.end()) {
+            Expr::m_throwError(ErrorCode::VARIABLE_NOT_FOUND, "Variable not found: " + vName);
+        }
+        return it->second;
+    }
+
+private:
+    String m_Expr;                                       // Compiled expression
+    Program m_Program;                                   // Program resolved with m_Functions
+    ::std::vector<Function> m_Functions;                 // Copies of the functions called by the program
+    FlatMap<VarHandle> m_VarSlots;                       // Slot of each variable of the expression
+    ::std::vector<double> m_VarValues;                   // Default values of the variables, indexed by slot
+    ::std::vector<bool> m_VarDefined;                    // Variables having a default value
+    ::std::unique_ptr<JitProgram> m_Jit;                 // Native code of the program, nullptr if not compiled
+
+    CompiledExpr() = default;
+};
+
+// Per thread state of the evaluation of a CompiledExpr : values of the variables, stacks and result
+class EvalContext {
+public:
+    explicit EvalContext(::std::shared_ptr<const CompiledExpr> vCompiled)
+        : m_Compiled(::std::move(vCompiled)), m_VarValues(m_Compiled->m_VarValues) {
+        const Program& program = m_Compiled->m_Program;
+        m_VarSources.assign(m_VarValues.size(), nullptr);
+        for (size_t idx = 0; idx < m_VarValues.size(); ++idx) {
+            if (m_Compiled->m_VarDefined[idx]) {
+                m_VarSources[idx] = &m_VarValues[idx];
+            }
+        }
+        m_Stack.resize(program.stackSize + program.tempsCount);
+    }
+
+    EvalContext(const EvalContext&)            = delete;  // the sources points on m_VarValues
+    EvalContext& operator=(const EvalContext&) = delete;
+    EvalContext(EvalContext&&)                 = default;
+    EvalContext& operator=(EvalContext&&)      = default;
+
+    // Returns the compiled expression evaluated
+    const CompiledExpr& getCompiled() const {
+        return *m_Compiled;
+    }
+
+    // Method to get the handle of a variable of the expression
+    VarHandle getVarHandle(const String& vName) const {
+        return m_Compiled->getVarHandle(vName);
+    }
+
+    // Method to set the value of a variable, the variables not in the expression are ignored
+    EvalContext& set(const String& vName, const double vValue) {
+        auto it = m_Compiled->m_VarSlots.find(vName);
+        if (it != m_Compiled->m_VarSlots.end()) {
+            set(it->second, vValue);
+        }
+        return *this;
+    }
+
+    // Method to set the value of a variable from its handle, without name lookup
+    EvalContext& set(const VarHandle vHandle, const double vValue) {
+        m_VarValues[vHandle.slot]  = vValue;
+        m_VarSources[vHandle.slot] = &m_VarValues[vHandle.slot];
+        return *this;
+    }
+
+    // Method to evaluate the expression
+    EvalContext& eval() {
+        double result = 0.0;
+        tryEval(result);
+        Expr::m_throwError(m_Error.code, m_Error.message);
+        return *this;
+    }
+
+    // Method to evaluate the expression without throwing, returns the error code, its message being given by getError()
+    // vResult and getResult() are set only if the evaluation succeeded
+    ErrorCode tryEval(double& vResult) {
+        m_clearError();
+        const JitProgram* jit = m_Compiled->m_Jit.get();
+        const bool isJitDone  = (jit != nullptr && jit->run(m_VarSources.data(), m_Stack.data(), m_EvalResult));
+        if (!isJitDone && Expr::m_run(m_Compiled->m_Program, m_VarSources.data(), m_Stack.data(), m_EvalResult, m_Error) != ErrorCode::NONE) {
+            return m_Error.code;
+        }
+        vResult = m_EvalResult;
+        return ErrorCode::NONE;
+    }
+
+    // Method to evaluate the expression for vCount rows, the values of the variables being read in columns of vCount values
+    // the variables without column keep their single value, and the columns of unknown variables are ignored
+    // if vErrors is not nullptr, the error of each row is written in it (ErrorCode::NONE if none) and doesn't stop the evaluation
+    EvalContext& evalBatch(const size_t vCount, const ::std::unordered_map<String, const double*>& vColumns, double* vOut, ErrorCode* vErrors = nullptr) {
+        tryEvalBatch(vCount, vColumns, vOut, vErrors);
+        Expr::m_throwError(m_Error.code, m_Error.message);
+        return *this;
+    }
+
+    // Method to evaluate the expression for vCount rows, with the columns of the variables given by handle
+    EvalContext& evalBatch(const size_t vCount, const ::std::vector< ::std::pair<VarHandle, const double*> >& vColumns, double* vOut, ErrorCode* vErrors = nullptr) {
+        tryEvalBatch(vCount, vColumns, vOut, vErrors);
+        Expr::m_throwError(m_Error.code, m_Error.message);
         return *this;
     }
 
-    // Method to enable or disable verbose mode
-    Expr& setVerbose(bool vVerbose) {
-        m_Verbose = vVerbose;
-        return *this;
+    // Method to evaluate the expression for vCount rows without throwing, returns the error code, its message being given by getError()
+    // with vErrors, only the errors not related to a row are returned, like a variable not defined
+    ErrorCode tryEvalBatch(const size_t vCount, const ::std::unordered_map<String, const double*>& vColumns, double* vOut, ErrorCode* vErrors = nullptr) {
+        m_BatchColumns.assign(m_VarSources.size(), nullptr);
+        for (const auto& column : vColumns) {
+            auto it = m_Compiled->m_VarSlots.find(column.first);
+            if (it != m_Compiled->m_VarSlots.end()) {
+                m_BatchColumns[it->second.slot] = column.second;
+            }
+        }
+        return m_evalBatch(vCount, vOut, vErrors);
+    }
+
+    // Method to evaluate the expression for vCount rows without throwing, with the columns of the variables given by handle
+    ErrorCode tryEvalBatch(const size_t vCount, const ::std::vector< ::std::pair<VarHandle, const double*> >& vColumns, double* vOut, ErrorCode* vErrors = nullptr) {
+        m_BatchColumns.assign(m_VarSources.size(), nullptr);
+        for (const auto& column : vColumns) {
+            m_BatchColumns[column.first.slot] = column.second;
+        }
+        return m_evalBatch(vCount, vOut, vErrors);
+    }
+
+    // Returns the evaluation result
+    double getResult() const {
+        return m_EvalResult;
+    }
+
+    // Returns the error of the last evaluation, its code being ErrorCode::NONE if it succeeded
+    const ExprError& getError() const {
+        return m_Error;
+    }
+
+private:
+    ::std::shared_ptr<const CompiledExpr> m_Compiled;  // Program evaluated
+    ::std::vector<double> m_VarValues;                 // Values of the variables, indexed by slot
+    ::std::vector<const double*> m_VarSources;         // Address read for each slot, nullptr if not defined
+    ::std::vector<double> m_Stack;                     // Values stack used during the evaluation
+    ::std::vector<double> m_BatchStack;                // Stack of blocks of values used during a batch evaluation
+    ::std::vector<const double*> m_BatchColumns;       // Column of the values of each slot in a batch, nullptr if none
+    double m_EvalResult = 0.0;                         // Evaluation result
+    ExprError m_Error;                                 // Error of the last evaluation
+
+    // Forget the error of the last evaluation
+    void m_clearError() {
+        if (m_Error.code != ErrorCode::NONE) {
+            m_Error = ExprError();
+        }
+    }
+
+    // Evaluate the program block by block, with the columns prepared in m_BatchColumns
+    ErrorCode m_evalBatch(const size_t vCount, double* vOut, ErrorCode* vRowErrors) {
+        m_clearError();
+        const Program& program = m_Compiled->m_Program;
+        m_BatchStack.resize((program.stackSize + program.tempsCount) * Expr::s_BatchBlockSize);
+        return Expr::m_evalRows(program, m_BatchColumns.data(), m_VarSources.data(), 0U, vCount, vOut, m_BatchStack.data(), vRowErrors, m_Error);
+    }
+};
+
+inline ::std::shared_ptr<const CompiledExpr> Expr::compile() {
+    m_clearError();
+    if (m_DefinedVarsDirty) {
+        m_loadDefinedVars();
+    }
+    if (m_Program.functionsRevision != m_FunctionsRevision && m_compile() != ErrorCode::NONE) {
+        m_throwError(m_Error.code, m_Error.message);  // the functions called or folded by the program may have changed
+    }
+    ::std::shared_ptr<CompiledExpr> compiled(new CompiledExpr());
+    compiled->m_Expr    = m_Expr;
+    compiled->m_Program = m_Program;
+    compiled->m_Functions.reserve(m_Program.functions.size());  // no reallocation, the program points on them
+    for (auto& fun : compiled->m_Program.functions) {
+        compiled->m_Functions.push_back(*fun.function);
+        fun.function = &compiled->m_Functions.back();
+    }
+    if (m_JitCompilation) {
+        compiled->m_Jit = JitProgram::create(compiled->m_Program);  // calling the copies of the functions
+    }
+    compiled->m_VarSlots = m_VarSlots;
+    compiled->m_VarValues.assign(m_VarSources.size(), 0.0);
+    compiled->m_VarDefined.assign(m_VarSources.size(), false);
+    for (size_t idx = 0; idx < m_VarSources.size(); ++idx) {
+        if (m_VarSources[idx] != nullptr) {
+            compiled->m_VarValues[idx]  = *m_VarSources[idx];  // the bound variables are read now
+            compiled->m_VarDefined[idx] = true;
+        }
+    }
+    return compiled;
+}
+
+inline void JitProgram::m_emitFunction(Bytes& vCode, const ProgramFunction& vFunction, uint32_t vDepth, ::std::vector<size_t>& vJumps) {
+    const Function* function = vFunction.function;
+    const uint32_t top       = vDepth - 1U;
+    if (function->builtin == BuiltinId::ABS) {
+        m_emitConstant(vCode, s_ScratchRegister, 0x7FFFFFFFFFFFFFFFULL);
+        m_emitXmm(vCode, 0x66U, 0x54U, top, s_ScratchRegister);  // andpd
+        return;
+    } else if (function->builtin == BuiltinId::SQRT) {
+        m_emitXmm(vCode, 0xF2U, 0x51U, top, top);  // sqrtsd
+        return;
+    } else if (function->builtin == BuiltinId::MIN) {
+        m_emitXmm(vCode, 0xF2U, 0x5DU, top - 1U, top);  // minsd, like m_Min : x < y ? x : y
+        return;
+    } else if (function->builtin == BuiltinId::MAX) {
+        m_emitXmm(vCode, 0xF2U, 0x5FU, top - 1U, top);  // maxsd, like m_Max : x > y ? x : y
+        return;
+    }
+    m_emit(vCode, {0x48U, 0xBFU});  // mov rdi, imm64
+    m_emitValue(vCode, reinterpret_cast<uint64_t>(function), 8U);
+    m_emit(vCode, {0x4CU, 0x89U, 0xE6U});  // mov rsi, r12
+    if (vFunction.argCount == 1U) {
+        m_emitCall(vCode, vDepth, 1U, reinterpret_cast<uint64_t>(&m_callUnary));
+    } else if (vFunction.argCount == 2U) {
+        m_emitCall(vCode, vDepth, 2U, reinterpret_cast<uint64_t>(&m_callBinary));
+    } else {
+        m_emitCall(vCode, vDepth, 3U, reinterpret_cast<uint64_t>(&m_callTernary));
+    }
+#ifdef USE_EXCEPTIONS
+    if (function->builtin == BuiltinId::NONE) {
+        m_emit(vCode, {0x41U, 0x80U, 0x3CU, 0x24U, 0x00U});  // cmp byte [r12], 0 : CallError::isFailed
+        m_emitJump(vCode, s_JumpIfNotEqual, vJumps);
+    }
+#else
+    (void)vJumps;
+#endif  // USE_EXCEPTIONS
+}
+
+inline ::std::unique_ptr<JitProgram> JitProgram::create(const Program& vProgram) {
+#ifdef USE_JIT
+    const bool isNodeChecked = (vProgram.errorCheck == ErrorCheckPolicy::EVERY_NODE || vProgram.errorCheck == ErrorCheckPolicy::STICKY_FLAGS);
+    Bytes code;
+    ::std::vector<size_t> jumps;  // jumps to the error exit
+    // push rbx, push rbp, push r12 : the stack stays aligned on 16 bytes for the calls
+    // mov rbx, rdi (sources), mov rbp, rsi (stack memory), mov r12, rdx (error of the calls)
+    m_emit(code, {0x53U, 0x55U, 0x41U, 0x54U, 0x48U, 0x89U, 0xFBU, 0x48U, 0x89U, 0xF5U, 0x49U, 0x89U, 0xD4U});
+    uint32_t depth = 0U;  // the value at the index i of the stack is in the register xmm i
+    for (const auto& ins : vProgram.code) {
+        switch (ins.op) {
+            case OpCode::PUSH_NUMBER: {
+                if (depth == s_RegistersCount) {
+                    return nullptr;
+                }
+                uint64_t bits = 0U;
+                ::std::memcpy(&bits, &vProgram.constants[ins.arg], sizeof(bits));
+                m_emitConstant(code, depth++, bits);
+            } break;
+            case OpCode::PUSH_VARIABLE: {
+                if (depth == s_RegistersCount) {
+                    return nullptr;
+                }
+                m_emit(code, {0x48U, 0x8BU, 0x83U});  // mov rax, [rbx + disp32]
+                m_emitValue(code, ins.arg * sizeof(const double*), 4U);
+                m_emit(code, {0x48U, 0x85U, 0xC0U});  // test rax, rax : variable not defined
+                m_emitJump(code, s_JumpIfEqual, jumps);
+                code.push_back(0xF2U);  // movsd xmm, [rax]
+                if (depth >= 8U) {
+                    code.push_back(0x44U);
+                }
+                m_emit(code, {0x0FU, 0x10U, static_cast<uint8_t>((depth & 7U) << 3U)});
+                ++depth;
+            } break;
+            case OpCode::ADD: {
+                --depth;
+                m_emitXmm(code, 0xF2U, 0x58U, depth - 1U, depth);  // addsd
+            } break;
+            case OpCode::SUB: {
+                --depth;
+                m_emitXmm(code, 0xF2U, 0x5CU, depth - 1U, depth);  // subsd
+            } break;
+            case OpCode::MUL: {
+                --depth;
+                m_emitXmm(code, 0xF2U, 0x59U, depth - 1U, depth);  // mulsd
+            } break;
+            case OpCode::DIV: {
+                --depth;
+                if (isNodeChecked) {
+                    m_emitCheckZero(code, depth, s_JumpIfEqual, jumps);
+                }
+                m_emitXmm(code, 0xF2U, 0x5EU, depth - 1U, depth);  // divsd
+            } break;
+            case OpCode::POW: {
+                if (isNodeChecked) {
+                    m_emitCheckZero(code, depth - 2U, s_JumpIfBelow, jumps);
+                }
+                m_emitCall(code, depth, 2U, reinterpret_cast<uint64_t>(&m_callPow));
+                --depth;
+            } break;
+            case OpCode::MOD: {
+                if (isNodeChecked) {
+                    m_emitCheckZero(code, depth - 1U, s_JumpIfEqual, jumps);
+                }
+                m_emitCall(code, depth, 2U, reinterpret_cast<uint64_t>(&m_callMod));
+                --depth;
+            } break;
+            case OpCode::NEG: {
+                m_emitConstant(code, s_ScratchRegister, 0x8000000000000000ULL);
+                m_emitXmm(code, 0x66U, 0x57U, depth - 1U, s_ScratchRegister);  // xorpd
+            } break;
+            case OpCode::POWI: {
+                if (isNodeChecked) {
+                    m_emitCheckZero(code, depth - 1U, s_JumpIfBelow, jumps);
+                }
+                code.push_back(0xBFU);  // mov edi, imm32 : exponent
+                m_emitValue(code, ins.arg, 4U);
+                m_emitCall(code, depth, 1U, reinterpret_cast<uint64_t>(&Expr::m_PowInt));
+            } break;
+            case OpCode::SQRT: {
+                m_emitXmm(code, 0xF2U, 0x51U, depth - 1U, depth - 1U);  // sqrtsd
+            } break;
+            case OpCode::STORE_TEMP: {
+                m_emitStackSlot(code, 0x11U, depth - 1U, vProgram.stackSize + ins.arg);
+            } break;
+            case OpCode::LOAD_TEMP: {
+                if (depth == s_RegistersCount) {
+                    return nullptr;
+                }
+                m_emitStackSlot(code, 0x10U, depth++, vProgram.stackSize + ins.arg);
+            } break;
+            case OpCode::CALL_UNARY:
+            case OpCode::CALL_BINARY:
+            case OpCode::CALL_TERNARY: {
+                const ProgramFunction& fun = vProgram.functions[ins.arg];
+                if (fun.function == nullptr || fun.argCount < 1U || fun.argCount > 3U) {
+                    return nullptr;
+                }
+                m_emitFunction(code, fun, depth, jumps);
+                depth -= static_cast<uint32_t>(fun.argCount) - 1U;
+            } break;
+            case OpCode::FACTORIAL: {
+                m_emitCall(code, depth, 1U, reinterpret_cast<uint64_t>(&Expr::m_Factorial));  // NaN if not defined
+            } break;
+            default: return nullptr;
+        }
+        // the temporaries are checked when computed
+        if (isNodeChecked && ins.op != OpCode::STORE_TEMP && ins.op != OpCode::LOAD_TEMP) {
+            m_emitCheckFinite(code, depth - 1U, jumps);
+        }
+    }
+    if (depth != 1U) {
+        return nullptr;
+    }
+    if (vProgram.errorCheck == ErrorCheckPolicy::FINAL_RESULT) {
+        m_emitCheckFinite(code, 0U, jumps);
+    }
+    m_emitStackSlot(code, 0x11U, 0U, 0U);  // the result in the first slot of the stack
+    m_emit(code, {0x31U, 0xC0U});          // xor eax, eax
+    m_emitEpilogue(code);
+    const size_t errorExit = code.size();
+    m_emit(code, {0xB8U, 0x01U, 0x00U, 0x00U, 0x00U});  // mov eax, 1
+    m_emitEpilogue(code);
+    for (const auto& jump : jumps) {
+        const auto offset = static_cast<uint32_t>(static_cast<int32_t>(errorExit - (jump + 4U)));
+        ::std::memcpy(&code[jump], &offset, sizeof(offset));
+    }
+
+    // the memory is writable then executable, never both
+    void* memory = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        return nullptr;
+    }
+    ::std::memcpy(memory, code.data(), code.size());
+    if (mprotect(memory, code.size(), PROT_READ | PROT_EXEC) != 0) {
+        munmap(memory, code.size());
+        return nullptr;
+    }
+    ::std::unique_ptr<JitProgram> jit(new JitProgram());
+    jit->m_Memory = memory;
+    jit->m_Size   = code.size();
+    return jit;
+#else
+    (void)vProgram;
+    return nullptr;
+#endif  // USE_JIT
+}
+
+#ifdef USE_CONSTEXPR_PARSING
+
+// Parsing of the expressions at compile time (C++17), with the grammar of Expr::m_parseExpression and Expr::m_parseFactor
+// EZ_EXPR("x + 2.5 * d") is a functor taking the variables in their order of first appearance, like Expr::toCppSource
+// its evaluation is expanded in the code of the caller like a hand written formula, with the results of ErrorCheckPolicy::NONE
+// only the builtins and the constants pi and e are known, a parsing error is a compilation error
+namespace ct {
+
+// Builtins called by the expressions parsed at compile time, with the definitions of Expr::defineDefaultBuiltins
+struct Builtins {
+    // Name and count of arguments of a builtin
+    struct Info {
+        const char* name;
+        BuiltinId id;
+        uint32_t argCount;
+    };
+
+    static constexpr Info s_Infos[] = {
+        {"abs", BuiltinId::ABS, 1U},
+        {"floor", BuiltinId::FLOOR, 1U},
+        {"ceil", BuiltinId::CEIL, 1U},
+        {"round", BuiltinId::ROUND, 1U},
+        {"fract", BuiltinId::FRACT, 1U},
+        {"sign", BuiltinId::SIGN, 1U},
+        {"sin", BuiltinId::SIN, 1U},
+        {"cos", BuiltinId::COS, 1U},
+        {"tan", BuiltinId::TAN, 1U},
+        {"asin", BuiltinId::ASIN, 1U},
+        {"acos", BuiltinId::ACOS, 1U},
+        {"atan", BuiltinId::ATAN, 1U},
+        {"sinh", BuiltinId::SINH, 1U},
+        {"cosh", BuiltinId::COSH, 1U},
+        {"tanh", BuiltinId::TANH, 1U},
+        {"asinh", BuiltinId::ASINH, 1U},
+        {"acosh", BuiltinId::ACOSH, 1U},
+        {"atanh", BuiltinId::ATANH, 1U},
+        {"ln", BuiltinId::LN, 1U},
+        {"log", BuiltinId::LOG, 1U},
+        {"log1p", BuiltinId::LOG1P, 1U},
+        {"logb", BuiltinId::LOGB, 1U},
+        {"log2", BuiltinId::LOG2, 1U},
+        {"log10", BuiltinId::LOG10, 1U},
+        {"sqrt", BuiltinId::SQRT, 1U},
+        {"exp", BuiltinId::EXP, 1U},
+        {"fact", BuiltinId::FACT, 1U},
+        {"saturate", BuiltinId::SATURATE, 1U},
+        {"mod", BuiltinId::MOD, 2U},
+        {"pow", BuiltinId::POW, 2U},
+        {"atan2", BuiltinId::ATAN2, 2U},
+        {"min", BuiltinId::MIN, 2U},
+        {"max", BuiltinId::MAX, 2U},
+        {"step", BuiltinId::STEP, 2U},
+        {"hypot", BuiltinId::HYPOT, 2U},
+        {"smoothabs", BuiltinId::SMOOTHABS, 2U},
+        {"clamp", BuiltinId::CLAMP, 3U},
+        {"lerp", BuiltinId::LERP, 3U},
+        {"mix", BuiltinId::MIX, 3U},
+        {"smoothstep", BuiltinId::SMOOTHSTEP, 3U},
+    };
+
+    // Call a builtin, the arguments after its count of arguments are ignored
+    template <BuiltinId tId>
+    static constexpr double call(const double vA, const double vB = 0.0, const double vC = 0.0) {
+        if constexpr (tId == BuiltinId::ABS) {
+            return ::std::abs(vA);
+        } else if constexpr (tId == BuiltinId::FLOOR) {
+            return ::std::floor(vA);
+        } else if constexpr (tId == BuiltinId::CEIL) {
+            return ::std::ceil(vA);
+        } else if constexpr (tId == BuiltinId::ROUND) {
+            return ::std::round(vA);
+        } else if constexpr (tId == BuiltinId::FRACT) {
+            return vA - ::std::floor(vA);
+        } else if constexpr (tId == BuiltinId::SIGN) {
+            return Expr::m_Sign(vA);
+        } else if constexpr (tId == BuiltinId::SIN) {
+            return ::std::sin(vA);
+        } else if constexpr (tId == BuiltinId::COS) {
+            return ::std::cos(vA);
+        } else if constexpr (tId == BuiltinId::TAN) {
+            return ::std::tan(vA);
+        } else if constexpr (tId == BuiltinId::ASIN) {
+            return ::std::asin(vA);
+        } else if constexpr (tId == BuiltinId::ACOS) {
+            return ::std::acos(vA);
+        } else if constexpr (tId == BuiltinId::ATAN) {
+            return ::std::atan(vA);
+        } else if constexpr (tId == BuiltinId::SINH) {
+            return ::std::sinh(vA);
+        } else if constexpr (tId == BuiltinId::COSH) {
+            return ::std::cosh(vA);
+        } else if constexpr (tId == BuiltinId::TANH) {
+            return ::std::tanh(vA);
+        } else if constexpr (tId == BuiltinId::ASINH) {
+            return ::std::asinh(vA);
+        } else if constexpr (tId == BuiltinId::ACOSH) {
+            return ::std::acosh(vA);
+        } else if constexpr (tId == BuiltinId::ATANH) {
+            return ::std::atanh(vA);
+        } else if constexpr (tId == BuiltinId::LN || tId == BuiltinId::LOG) {
+            return ::std::log(vA);
+        } else if constexpr (tId == BuiltinId::LOG1P) {
+            return ::std::log1p(vA);
+        } else if constexpr (tId == BuiltinId::LOGB) {
+            return ::std::logb(vA);
+        } else if constexpr (tId == BuiltinId::LOG2) {
+            return ::std::log2(vA);
+        } else if constexpr (tId == BuiltinId::LOG10) {
+            return ::std::log10(vA);
+        } else if constexpr (tId == BuiltinId::SQRT) {
+            return ::std::sqrt(vA);
+        } else if constexpr (tId == BuiltinId::EXP) {
+            return ::std::exp(vA);
+        } else if constexpr (tId == BuiltinId::FACT) {
+            return Expr::m_Factorial(vA);
+        } else if constexpr (tId == BuiltinId::SATURATE) {
+            return Expr::m_Clamp(vA, 0.0, 1.0);
+        } else if constexpr (tId == BuiltinId::MOD) {
+            return ::std::fmod(vA, vB);
+        } else if constexpr (tId == BuiltinId::POW) {
+            return ::std::pow(vA, vB);  // evaluated like the operator ^, see Expr::m_emitNode
+        } else if constexpr (tId == BuiltinId::ATAN2) {
+            return ::std::atan2(vA, vB);
+        } else if constexpr (tId == BuiltinId::MIN) {
+            return Expr::m_Min(vA, vB);
+        } else if constexpr (tId == BuiltinId::MAX) {
+            return Expr::m_Max(vA, vB);
+        } else if constexpr (tId == BuiltinId::STEP) {
+            return Expr::m_Step(vA, vB);
+        } else if constexpr (tId == BuiltinId::HYPOT) {
+            return ::std::hypot(vA, vB);
+        } else if constexpr (tId == BuiltinId::SMOOTHABS) {
+            return Expr::m_SmoothAbs(vA, vB);
+        } else if constexpr (tId == BuiltinId::CLAMP) {
+            return Expr::m_Clamp(vA, vB, vC);
+        } else if constexpr (tId == BuiltinId::LERP || tId == BuiltinId::MIX) {
+            return Expr::m_Mix(vA, vB, vC);
+        } else {
+            static_assert(tId == BuiltinId::SMOOTHSTEP, "not a builtin");
+            return Expr::m_SmoothStep(vA, vB, vC);
+        }
+    }
+};
+
+// Node of a syntax tree parsed at compile time, the childs being indexes in the nodes of the tree
+struct Node {
+    NodeType type       = NodeType::NUMBER;
+    OpCode op           = OpCode::Count;    // operator code of an OPERATOR node
+    BuiltinId builtin   = BuiltinId::NONE;  // builtin called by a FUNCTION node
+    double value        = 0.0;              // value of a NUMBER node
+    uint32_t slot       = 0U;               // slot of a VARIABLE node
+    uint32_t childs[3]  = {};
+    uint32_t childCount = 0U;
+};
+
+// Syntax tree parsed at compile time, a token giving at most one node so there is at most one node per character
+template <size_t tCapacity>
+struct Tree {
+    Node nodes[tCapacity] = {};
+    uint32_t nodesCount   = 0U;
+    uint32_t root         = 0U;
+    size_t varsOffsets[tCapacity] = {};  // offset in the expression of the name of the variable of each slot
+    size_t varsLengths[tCapacity] = {};  // length of the name of the variable of each slot
+    uint32_t varsCount    = 0U;
+    ErrorCode error       = ErrorCode::NONE;  // error of the parsing, ErrorCode::NONE if none
+    size_t errorOffset    = 0U;               // offset in the expression of the token of the error
+};
+
+// Token read at compile time, TokenType::Count at the end of the expression
+struct Token {
+    TokenType type = TokenType::Count;
+    OpCode op      = OpCode::Count;  // operator code of an OPERATOR token, Count if the operator is unknown
+    double value   = 0.0;            // value of a NUMBER token
+    size_t offset  = 0U;             // offset of the token in the expression
+    size_t length  = 0U;
+};
+
+// Returns the length of an expression
+constexpr size_t getLength(const char* vExpr) {
+    size_t length = 0U;
+    while (vExpr[length] != '\0') {
+        ++length;
+    }
+    return length;
+}
+
+// Unsigned integer of s_LimbsCount * 32 bits, for the exact reading of the number literals at compile time
+// large enough for the 800 significant digits of a literal scaled to the range of the doubles
+class BigInteger {
+public:
+    static constexpr size_t s_LimbsCount = 144U;
+
+    constexpr BigInteger() = default;
+
+    constexpr explicit BigInteger(const uint64_t vValue) {
+        m_Limbs[0] = static_cast<uint32_t>(vValue);
+        m_Limbs[1] = static_cast<uint32_t>(vValue >> 32U);
+        m_Count    = (m_Limbs[1] != 0U) ? 2U : (m_Limbs[0] != 0U ? 1U : 0U);
+    }
+
+    // this = this * vMul + vAdd
+    constexpr void mulAdd(const uint32_t vMul, const uint32_t vAdd) {
+        uint64_t carry = vAdd;
+        for (size_t idx = 0; idx < m_Count; ++idx) {
+            const uint64_t value = static_cast<uint64_t>(m_Limbs[idx]) * vMul + carry;
+            m_Limbs[idx]         = static_cast<uint32_t>(value);
+            carry                = value >> 32U;
+        }
+        if (carry != 0U) {
+            m_Limbs[m_Count++] = static_cast<uint32_t>(carry);
+        }
+    }
+
+    // this = this * 5^vPower
+    constexpr void mulPow5(uint32_t vPower) {
+        for (; vPower >= 13U; vPower -= 13U) {
+            mulAdd(1220703125U, 0U);  // 5^13, the greatest power of 5 of 32 bits
+        }
+        uint32_t power = 1U;
+        for (; vPower != 0U; --vPower) {
+            power *= 5U;
+        }
+        mulAdd(power, 0U);
+    }
+
+    // this = this * 2^vBits
+    constexpr void shiftLeft(const uint32_t vBits) {
+        if (m_Count == 0U) {
+            return;
+        }
+        const size_t limbs = vBits / 32U;
+        const uint32_t bits = vBits % 32U;
+        m_Limbs[m_Count + limbs] = 0U;
+        for (size_t idx = m_Count; idx-- > 0U;) {
+            const uint32_t limb = m_Limbs[idx];
+            if (bits != 0U) {
+                m_Limbs[idx + limbs + 1U] |= limb >> (32U - bits);
+            }
+            m_Limbs[idx + limbs] = limb << bits;
+        }
+        for (size_t idx = 0; idx < limbs; ++idx) {
+            m_Limbs[idx] = 0U;
+        }
+        m_Count += limbs + 1U;
+        m_trim();
+    }
+
+    // this = this / 2
+    constexpr void shiftRight1() {
+        for (size_t idx = 0; idx < m_Count; ++idx) {
+            m_Limbs[idx] = (m_Limbs[idx] >> 1U) | ((idx + 1U < m_Count) ? (m_Limbs[idx + 1U] << 31U) : 0U);
+        }
+        m_trim();
     }
 
-    // Returns the evaluation result
-    double getResult() {
-        return m_EvalResult;
+    // this = this - vOther, vOther being lower or equal
+    constexpr void sub(const BigInteger& vOther) {
+        int64_t borrow = 0;
+        for (size_t idx = 0; idx < m_Count; ++idx) {
+            int64_t value = static_cast<int64_t>(m_Limbs[idx]) - borrow - (idx < vOther.m_Count ? static_cast<int64_t>(vOther.m_Limbs[idx]) : 0);
+            borrow        = (value < 0) ? 1 : 0;
+            m_Limbs[idx]  = static_cast<uint32_t>(value + (borrow << 32U));
+        }
+        m_trim();
     }
 
-    // Prints the expression and its result
-    Expr& print() {
-        m_printExpr = {};
-        m_printExpr << "Expr \"" << m_Expr << "\"";
-        for (const auto& it : m_DefinedVariables) {
-            m_printExpr << ", " << it.first << " = " << it.second;
+    // Returns -1, 0 or 1 if this is lower, equal or greater than vOther
+    constexpr int compare(const BigInteger& vOther) const {
+        if (m_Count != vOther.m_Count) {
+            return (m_Count < vOther.m_Count) ? -1 : 1;
         }
-        m_printExpr << " => " << m_EvalResult;
-        ::std::cout << m_printExpr.str() << " (" << getEvalTime() << " ms)" << ::std::endl;
-        return *this;
+        for (size_t idx = m_Count; idx-- > 0U;) {
+            if (m_Limbs[idx] != vOther.m_Limbs[idx]) {
+                return (m_Limbs[idx] < vOther.m_Limbs[idx]) ? -1 : 1;
+            }
+        }
+        return 0;
     }
 
-    // Checks if the evaluation result is close to a given value
-    bool check(const double vValue) {
-        return (::std::abs(m_EvalResult - vValue) < 0.001);
+    // Returns the count of significant bits
+    constexpr int32_t getBitsCount() const {
+        if (m_Count == 0U) {
+            return 0;
+        }
+        int32_t bits = static_cast<int32_t>(m_Count - 1U) * 32;
+        for (uint32_t limb = m_Limbs[m_Count - 1U]; limb != 0U; limb >>= 1U) {
+            ++bits;
+        }
+        return bits;
     }
 
-    // test if a variable found during parsing exist
-    bool isParsedVariableExist(const String& vName) {
-        return (m_ParsedVariables.find(vName) != m_ParsedVariables.end());
+    constexpr bool isZero() const {
+        return m_Count == 0U;
     }
 
-    // Returns variables as a constant reference
-    const VarContainer& getParsedVars() {
-        return m_ParsedVariables;
+private:
+    uint32_t m_Limbs[s_LimbsCount + 1U] = {};  // Least significant limb first, one more for the carry of the shifts
+    size_t m_Count                       = 0U;  // Count of limbs used, the most significant one being not 0
+
+    constexpr void m_trim() {
+        while (m_Count != 0U && m_Limbs[m_Count - 1U] == 0U) {
+            --m_Count;
+        }
     }
+};
 
-    // Returns variables as a modifiable reference
-    VarContainer& getParsedVarsRef() {
-        return m_ParsedVariables;
+// Recursive descent parser evaluated at compile time, the tokens being read one by one with the rules of Expr::m_tokenize
+template <size_t tCapacity>
+class Parser {
+public:
+    constexpr explicit Parser(const char* vExpr) : m_Expr(vExpr) {
     }
 
-    // test if a defined variable exist
-    bool isDefinedVariableExist(const String& vName) {
-        return (m_DefinedVariables.find(vName) != m_ParsedVariables.end());
+    // Parse the expression, the error being given by the tree
+    constexpr Tree<tCapacity> parse() {
+        m_next();
+        uint32_t root = 0U;
+        if (m_parseExpression(0, root) && m_Token.type != TokenType::Count) {
+            m_fail(m_Token.type == TokenType::RPAREN ? ErrorCode::UNMATCHED_PARENTHESIS : ErrorCode::PARSE_ERROR);
+        }
+        m_Tree.root = root;
+        return m_Tree;
     }
 
-    // Returns defined variables as a constant reference
-    const VarContainer& getDefinedVars() {
-        return m_DefinedVariables;
+private:
+    const char* m_Expr = nullptr;  // Expression to parse
+    size_t m_Pos       = 0U;       // Offset of the next character to read
+    Token m_Token;                 // Current token
+    Tree<tCapacity> m_Tree;        // Tree parsed
+
+    static constexpr int32_t s_MaxNumberDigits = 800;  // significant digits of a number literal kept, like Expr::s_MaxNumberDigits
+
+    static constexpr bool m_isDigit(const char vCh) {
+        return vCh >= '0' && vCh <= '9';
     }
 
-    // Returns defined variables as a modifiable reference
-    VarContainer& getDefinedVarsRef() {
-        return m_DefinedVariables;
+    static constexpr bool m_isAlpha(const char vCh) {
+        return (vCh >= 'a' && vCh <= 'z') || (vCh >= 'A' && vCh <= 'Z');
     }
 
-protected:
-    // Tokenize the expression
-    ::std::vector<Token> m_tokenize(const char* expr) {
-        ::std::vector<Token> tokens;
-        ::std::istringstream stream(expr);
-        char ch;
-        while (stream >> ch) {
-            if (::std::isdigit(ch) || ch == '.') {
-                stream.putback(ch);
-                double number;
-                stream >> number;
-                tokens.push_back({TokenType::NUMBER, String::fromDouble(number)});
-            } else if (::std::isalpha(ch)) {
-                String identifier(ch);
-                while (stream.get(ch) && ::std::isalnum(ch)) {
-                    identifier = identifier + String(ch);
-                }
-                stream.putback(ch);
-                tokens.push_back({TokenType::VARIABLE, identifier});  // Traitement gnrique comme identifiant
-            } else if (ch == '(') {
-                tokens.push_back({TokenType::LPAREN, String("(")});
-            } else if (ch == ')') {
-                tokens.push_back({TokenType::RPAREN, String(")")});
-            } else if (ch == ',') {
-                tokens.push_back({TokenType::SEPARATOR, String(",")});
-            } else {
-                String op(ch);
-                while (stream.get(ch) && !::std::isalnum(ch) && ch != ' ' && ch != '(' && ch != ')' && ch != ',') {
-                    op = op + String(ch);
-                }
-                stream.putback(ch);
-                tokens.push_back({TokenType::OPERATOR, op});
-            }
+    static constexpr bool m_isAlnum(const char vCh) {
+        return m_isDigit(vCh) || m_isAlpha(vCh);
+    }
+
+    static constexpr bool m_isSpace(const char vCh) {
+        return vCh == ' ' || (vCh >= '\t' && vCh <= '\r');
+    }
+
+    // Same codes than Expr::m_getOperatorCode
+    static constexpr OpCode m_getOperatorCode(const char vCh) {
+        switch (vCh) {
+            case '+': return OpCode::ADD;
+            case '-': return OpCode::SUB;
+            case '*': return OpCode::MUL;
+            case '/': return OpCode::DIV;
+            case '^': return OpCode::POW;
+            case '%': return OpCode::MOD;
+            case '!': return OpCode::FACTORIAL;
+            default: return OpCode::Count;
         }
-        if (m_Verbose) {
-            m_log("Tokens: ");
-            for (const auto& token : tokens) {
-                m_log(token.value + " ");
-            }
-            m_log("\n");
+    }
+
+    // Same precedences than Expr::m_getPrecedence
+    static constexpr int m_getPrecedence(const OpCode vOp) {
+        switch (vOp) {
+            case OpCode::ADD:
+            case OpCode::SUB: return 1;
+            case OpCode::MUL:
+            case OpCode::DIV:
+            case OpCode::MOD: return 2;
+            case OpCode::POW: return 3;
+            default: return 0;
         }
-        return tokens;
     }
 
-    // Logs messages if verbose mode is enabled
-    void m_log(const String& message) {
-        if (m_Verbose) {
-            ::std::cout << message.c_str();
+    // Returns vValue * 2^vExponent, exact when the result is a double
+    static constexpr double m_getScaled(const uint64_t vValue, int32_t vExponent) {
+        double value = static_cast<double>(vValue);
+        for (; vExponent >= 32; vExponent -= 32) {
+            value *= 4294967296.0;
         }
+        for (; vExponent <= -32; vExponent += 32) {
+            value /= 4294967296.0;
+        }
+        for (; vExponent > 0; --vExponent) {
+            value *= 2.0;
+        }
+        for (; vExponent < 0; ++vExponent) {
+            value *= 0.5;
+        }
+        return value;
     }
 
-    // Evaluate a node in the syntax tree
-    void m_evalNode(Node& node, double& vOutResult) {
-        switch (node.type) {
-            case NodeType::NUMBER: {
-                vOutResult = node.value;
-            } break;
-            case NodeType::OPERATOR: {
-                m_evalNode(*node.childs[0], node.tmp[0]);  // left
-                m_evalNode(*node.childs[1], node.tmp[1]);  // right
-                if (node.name[0] == '+') {
-                    vOutResult = node.tmp[0] + node.tmp[1];
-                } else if (node.name[0] == '-') {
-                    vOutResult = node.tmp[0] - node.tmp[1];
-                } else if (node.name[0] == '*') {
-                    vOutResult = node.tmp[0] * node.tmp[1];
-                } else if (node.name[0] == '/') {
-                    if (node.tmp[1] == 0.0) {
-                        throw ExprException(ErrorCode::DIVISION_BY_ZERO, "Division by zero");
-                    }
-                    vOutResult = node.tmp[0] / node.tmp[1];
-                } else if (node.name[0] == '^') {
-                    if (node.tmp[0] < 0.0) {
-                        throw ExprException(ErrorCode::EVALUATION_NAN, "Pow base value is negative");
-                    }
-                    vOutResult = ::std::pow(node.tmp[0], node.tmp[1]);
-                } else if (node.name[0] == '%') {
-                    if (node.tmp[1] == 0.0) {
-                        throw ExprException(ErrorCode::DIVISION_BY_ZERO, "Division by zero");
-                    }
-                    vOutResult = ::std::fmod(node.tmp[0], node.tmp[1]);
-                }
-            } break;
-            case NodeType::VARIABLE: {
-                auto it = m_DefinedVariables.find(node.name);
-                if (it == m_DefinedVariables.end()) {
-                    throw ExprException(ErrorCode::VARIABLE_NOT_FOUND, "Variable not found: " + node.name);
-                }
-                vOutResult = it->second;
-            } break;
-            case NodeType::FUNCTION: {
-                auto it = m_Functions.find(node.name);
-                if (it == m_Functions.end()) {
-                    // Special case handling for the "!" operator (factorial)
-                    if (node.name[0] == '!') {
-                        m_evalNode(*node.childs[0], node.tmp[0]);
-                        vOutResult = m_Factorial(node.tmp[0]);  // Call the factorial function
-                    } else {
-                        throw ExprException(ErrorCode::FUNCTION_NOT_FOUND, "Function not found: " + node.name);
+    // Returns the nearest double of vDigits * 10^vScale, the ties to even like strtod, vDigitsCount being the count of digits
+    static constexpr double m_getNearestNumber(const BigInteger& vDigits, const int32_t vDigitsCount, const int32_t vScale) {
+        if (vDigits.isZero() || vDigitsCount + vScale < -324) {
+            return 0.0;  // lower than the half of the lowest subnormal
+        } else if (vDigitsCount + vScale > 310) {
+            return ::std::numeric_limits<double>::infinity();
+        }
+        // the value is numerator / denominator
+        BigInteger numerator = vDigits;
+        BigInteger denominator(1U);
+        if (vScale >= 0) {
+            numerator.mulPow5(static_cast<uint32_t>(vScale));
+            numerator.shiftLeft(static_cast<uint32_t>(vScale));
+        } else {
+            denominator.mulPow5(static_cast<uint32_t>(-vScale));
+            denominator.shiftLeft(static_cast<uint32_t>(-vScale));
+        }
+        // the value is in [2^(bits - 1), 2^(bits + 1)), so its quotient by 2^exponent has 53 or 54 bits, less for a subnormal
+        const int32_t bits = numerator.getBitsCount() - denominator.getBitsCount();
+        int32_t exponent   = (bits - 53 < -1074) ? -1074 : bits - 53;
+        if (exponent < 0) {
+            numerator.shiftLeft(static_cast<uint32_t>(-exponent));
+        } else {
+            denominator.shiftLeft(static_cast<uint32_t>(exponent));
+        }
+        // quotient bit by bit, the remainder being left in the numerator
+        denominator.shiftLeft(53U);
+        uint64_t quotient = 0U;
+        for (int32_t bit = 53; bit >= 0; --bit) {
+            if (numerator.compare(denominator) >= 0) {
+                numerator.sub(denominator);
+                quotient |= 1ULL << static_cast<uint32_t>(bit);
+            }
+            if (bit != 0) {
+                denominator.shiftRight1();
+            }
+        }
+        if (quotient >= (1ULL << 53U)) {  // 54 bits, the lowest one is rounded with the remainder
+            const bool isHalf = (quotient & 1U) != 0U;
+            quotient >>= 1U;
+            ++exponent;
+            if (isHalf && (!numerator.isZero() || (quotient & 1U) != 0U)) {
+                ++quotient;
+            }
+        } else {
+            numerator.shiftLeft(1U);  // twice the remainder, compared to the denominator
+            const int cmp = numerator.compare(denominator);
+            if (cmp > 0 || (cmp == 0 && (quotient & 1U) != 0U)) {
+                ++quotient;
+            }
+        }
+        if (quotient == (1ULL << 53U)) {
+            quotient >>= 1U;
+            ++exponent;
+        }
+        if (exponent > 971) {
+            return ::std::numeric_limits<double>::infinity();
+        }
+        return m_getScaled(quotient, exponent);
+    }
+
+    // Read a number like Expr::m_readNumber : digits, point, digits and an optional exponent, to the same nearest double
+    constexpr bool m_readNumber(double& vValue) {
+        constexpr double s_Powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        BigInteger digits;           // the significant digits kept
+        uint64_t mantissa  = 0U;     // the 19 first significant digits, for the exact cases
+        uint32_t chunk     = 0U;     // digits given by 9 to the big integer
+        uint32_t chunkSize = 1U;     // 10^count of digits of the chunk
+        int32_t count      = 0;      // count of significant digits kept
+        int32_t scale      = 0;      // the literal is the integer of the digits * 10^scale
+        bool hasDigits     = false;
+        bool hasDropped    = false;
+        bool isFraction    = false;
+        for (;; ++m_Pos) {
+            const char ch = m_Expr[m_Pos];
+            if (ch == '.' && !isFraction) {
+                isFraction = true;
+            } else if (m_isDigit(ch)) {
+                hasDigits = true;
+                if (count == 0 && ch == '0') {
+                    scale -= isFraction ? 1 : 0;  // leading zero
+                } else if (count < s_MaxNumberDigits) {
+                    const uint32_t digit = static_cast<uint32_t>(ch - '0');
+                    mantissa             = (count < 19) ? mantissa * 10U + digit : mantissa;
+                    chunk                = chunk * 10U + digit;
+                    chunkSize *= 10U;
+                    if (chunkSize == 1000000000U) {
+                        digits.mulAdd(chunkSize, chunk);
+                        chunk     = 0U;
+                        chunkSize = 1U;
                     }
+                    ++count;
+                    scale -= isFraction ? 1 : 0;
                 } else {
-                    if (it->second.argCount == 1) {
-                        m_evalNode(*node.childs[0], node.tmp[0]);
-                        vOutResult = it->second.unaryFunctor(node.tmp[0]);  // first
-                    } else if (it->second.argCount == 2) {
-                        m_evalNode(*node.childs[0], node.tmp[0]);  // first
-                        m_evalNode(*node.childs[1], node.tmp[1]);  // second
-                        vOutResult = it->second.binaryFunctor(node.tmp[0], node.tmp[1]);
-                    } else if (it->second.argCount == 3) {
-                        m_evalNode(*node.childs[0], node.tmp[0]);  // first
-                        m_evalNode(*node.childs[1], node.tmp[1]);  // second
-                        m_evalNode(*node.childs[2], node.tmp[2]);  // third
-                        vOutResult = it->second.ternaryFunctor(node.tmp[0], node.tmp[1], node.tmp[2]);
+                    hasDropped = hasDropped || (ch != '0');
+                    scale += isFraction ? 0 : 1;
+                }
+            } else {
+                break;
+            }
+        }
+        digits.mulAdd(chunkSize, chunk);
+        const char ch = m_Expr[m_Pos];
+        if (hasDigits && (ch == 'e' || ch == 'E')) {
+            size_t pos       = m_Pos + 1U;
+            const bool isNeg = (m_Expr[pos] == '-');
+            if (m_Expr[pos] == '-' || m_Expr[pos] == '+') {
+                ++pos;
+            }
+            if (m_isDigit(m_Expr[pos])) {
+                int32_t value = 0;
+                for (; m_isDigit(m_Expr[pos]); ++pos) {
+                    if (value < 100000) {
+                        value = value * 10 + (m_Expr[pos] - '0');
                     }
                 }
-            } break;
-            default:
-                throw ExprException(ErrorCode::UNKNOWN_NODE_TYPE, "Unknown node type");
+                scale += isNeg ? -value : value;
+                m_Pos = pos;
+            }
         }
-
-        // Vrification du rsultat pour NaN ou Inf
-        if (::std::isnan(vOutResult)) {
-            throw ExprException(ErrorCode::EVALUATION_NAN, "Result is NaN");
-        } else if (::std::isinf(vOutResult)) {
-            throw ExprException(ErrorCode::EVALUATION_INF, "Result is Inf");
+        if (hasDropped) {
+            digits.mulAdd(10U, 1U);  // between the kept digits and the next ones, for the rounding
+            ++count;
+            --scale;
         }
-
-        if (m_Verbose) {
-            m_log("Evaluating Node: " + String::fromDouble(vOutResult) + "\n");
+        if (count == 0) {
+            vValue = 0.0;
+        } else if (count <= 19 && scale >= -22 && scale <= 22 && mantissa <= (1ULL << 53U)) {
+            vValue = scale < 0 ? static_cast<double>(mantissa) / s_Powers[-scale] : static_cast<double>(mantissa) * s_Powers[scale];
+        } else {
+            vValue = m_getNearestNumber(digits, count, scale);
         }
+        return hasDigits;
     }
 
-    // Parse an expression to create a syntax tree
-    Node m_parseExpression(::std::vector<Token>& tokens, size_t& pos, int precedence) {
-        if (pos >= tokens.size()) {
-            throw ExprException(ErrorCode::PARSE_ERROR, "Unexpected end of expression");
+    // Read the next token in m_Token
+    constexpr void m_next() {
+        while (m_isSpace(m_Expr[m_Pos])) {
+            ++m_Pos;
         }
-        Node node = m_parseFactor(tokens, pos);
-        while (pos < tokens.size()) {
-            String op        = tokens[pos].value;
-            int opPrecedence = 0;
-            if (tokens[pos].type == TokenType::OPERATOR) {
-                if (op == "+" || op == "-" || op == "*" || op == "/" || op == "^" || op == "%" || op == "!") {
-                    opPrecedence = (op == "+" || op == "-") ? 1 : (op == "*" || op == "/" || op == "%") ? 2
-                                                                                                        : 3;
-                } else {
-                    throw ExprException(ErrorCode::OPERATOR_NOT_FOUND, "Operator not found: " + op);
-                }
+        Token token;
+        token.offset  = m_Pos;
+        const char ch = m_Expr[m_Pos];
+        if (ch == '\0') {
+            token.type = TokenType::Count;
+        } else if (m_isDigit(ch) || ch == '.') {
+            token.type = TokenType::NUMBER;
+            if (!m_readNumber(token.value)) {
+                m_Token = token;
+                m_fail(ErrorCode::PARSE_ERROR);  // a point alone
+                token.type = TokenType::Count;
             }
-            if (opPrecedence <= precedence) {
-                break;
+        } else if (m_isAlpha(ch)) {
+            token.type = TokenType::VARIABLE;
+            while (m_isAlnum(m_Expr[++m_Pos])) {
             }
-            ++pos;
-            if (pos >= tokens.size()) {
-                throw ExprException(ErrorCode::PARSE_ERROR, "Incomplete expression after operator: " + op);
+        } else if (ch == '(' || ch == ')' || ch == ',') {
+            token.type = (ch == '(') ? TokenType::LPAREN : (ch == ')') ? TokenType::RPAREN : TokenType::SEPARATOR;
+            ++m_Pos;
+        } else {
+            // the characters of an operator are read until a letter, a digit, a space, a parenthesis or a comma
+            token.type = TokenType::OPERATOR;
+            for (char next = m_Expr[++m_Pos]; next != '\0' && !m_isAlnum(next) && next != ' ' && next != '(' && next != ')' && next != ','; next = m_Expr[++m_Pos]) {
             }
-            Node rightNode = m_parseExpression(tokens, pos, opPrecedence);
-            Node opNode;
-            opNode.type       = NodeType::OPERATOR;
-            opNode.name       = op;
-            opNode.childCount = 2;
-            opNode.childs[0]  = ::std::make_shared<Node>(node);
-            opNode.childs[1]  = ::std::make_shared<Node>(rightNode);
-            node              = opNode;
+            token.op = (m_Pos - token.offset == 1U) ? m_getOperatorCode(ch) : OpCode::Count;
         }
-        return node;
+        token.length = m_Pos - token.offset;
+        m_Token      = token;
     }
 
-    // Parse a factor in an expression (number, variable, parenthesis, function)
-    Node m_parseFactor(::std::vector<Token>& tokens, size_t& pos) {
-        Node node;
-        if (pos >= tokens.size()) {
-            throw ExprException(ErrorCode::PARSE_ERROR, "Unexpected end of expression");
+    // Keep the first error, returns false
+    constexpr bool m_fail(const ErrorCode vCode) {
+        if (m_Tree.error == ErrorCode::NONE) {
+            m_Tree.error       = vCode;
+            m_Tree.errorOffset = m_Token.offset;
         }
+        return false;
+    }
 
-        if (tokens[pos].type == TokenType::NUMBER) {
-            node.type  = NodeType::NUMBER;
-            node.value = ::std::stod(tokens[pos].value.c_str());
-            ++pos;
+    // Returns true if the name of a token is vName
+    constexpr bool m_isName(const Token& vToken, const char* vName) const {
+        size_t idx = 0U;
+        for (; idx < vToken.length; ++idx) {
+            if (vName[idx] != m_Expr[vToken.offset + idx]) {
+                return false;
+            }
+        }
+        return vName[idx] == '\0';
+    }
 
-            // Gestion de l'oprateur postfix "!" pour les nombres
-            if (pos < tokens.size() && tokens[pos].type == TokenType::OPERATOR && tokens[pos].value == "!") {
-                Node opNode;
-                opNode.type       = NodeType::FUNCTION;
-                opNode.name       = "!";
-                opNode.childs[0]  = ::std::make_shared<Node>(node);
-                opNode.childCount = 1;
-                node              = opNode;  // Remplacer le nud par l'oprateur postfix
-                ++pos;
+    // Returns true if two names of the expression are the same
+    constexpr bool m_isSameName(const size_t vOffset, const size_t vLength, const Token& vToken) const {
+        if (vLength != vToken.length) {
+            return false;
+        }
+        for (size_t idx = 0U; idx < vLength; ++idx) {
+            if (m_Expr[vOffset + idx] != m_Expr[vToken.offset + idx]) {
+                return false;
             }
-        } else if (tokens[pos].type == TokenType::VARIABLE) {
-            String identifier = tokens[pos].value;
-            ++pos;
+        }
+        return true;
+    }
 
-            if (pos < tokens.size() && tokens[pos].type == TokenType::LPAREN) {
-                auto it = m_Functions.find(identifier);
-                if (it == m_Functions.end()) {
-                    throw ExprException(ErrorCode::FUNCTION_NOT_FOUND, "Function not found: " + identifier);
-                }
+    // Add a node to the tree and returns its index
+    constexpr uint32_t m_addNode(const NodeType vType) {
+        const uint32_t idx   = m_Tree.nodesCount++;
+        m_Tree.nodes[idx].type = vType;
+        return idx;
+    }
 
-                ++pos;  // Passer la parenthse ouvrante
+    // Add a node applying an operator to one or two nodes, and returns its index
+    constexpr uint32_t m_addOperator(const OpCode vOp, const uint32_t vLeft, const uint32_t vRight, const uint32_t vCount) {
+        const uint32_t idx  = m_addNode(NodeType::OPERATOR);
+        Node& node          = m_Tree.nodes[idx];
+        node.op             = vOp;
+        node.childs[0]      = vLeft;
+        node.childs[1]      = vRight;
+        node.childCount     = vCount;
+        return idx;
+    }
 
-                if (pos < tokens.size() && tokens[pos].type == TokenType::RPAREN) {
-                    throw ExprException(ErrorCode::FUNCTION_WRONG_ARGUMENTS_COUNT, "Function called with incorrect number of arguments: " + identifier);
-                }
+    // Apply the postfix operator ! to a node if it follows it
+    constexpr void m_parsePostfix(uint32_t& vNode) {
+        if (m_Token.type == TokenType::OPERATOR && m_Token.op == OpCode::FACTORIAL) {
+            vNode = m_addOperator(OpCode::FACTORIAL, vNode, 0U, 1U);
+            m_next();
+        }
+    }
 
-                node.type       = NodeType::FUNCTION;
-                node.name       = identifier;
-                node.childs[0]  = ::std::make_shared<Node>(m_parseExpression(tokens, pos, 0));
-                node.childCount = 1;
+    // Same rules than Expr::m_parseExpression
+    constexpr bool m_parseExpression(const int vPrecedence, uint32_t& vNode) {
+        if (m_Token.type == TokenType::Count) {
+            return m_fail(ErrorCode::PARSE_ERROR);  // unexpected end of expression
+        }
+        uint32_t node = 0U;
+        if (!m_parseFactor(node)) {
+            return false;
+        }
+        while (m_Token.type != TokenType::Count) {
+            int opPrecedence = 0;
+            if (m_Token.type == TokenType::OPERATOR) {
+                if (m_Token.op == OpCode::FACTORIAL) {
+                    return m_fail(ErrorCode::PARSE_ERROR);  // factorial following another factorial
+                }
+                opPrecedence = m_getPrecedence(m_Token.op);
+                if (opPrecedence == 0) {
+                    return m_fail(ErrorCode::OPERATOR_NOT_FOUND);
+                }
+            }
+            if (opPrecedence <= vPrecedence) {
+                break;
+            }
+            const OpCode op = m_Token.op;
+            m_next();
+            if (m_Token.type == TokenType::Count) {
+                return m_fail(ErrorCode::PARSE_ERROR);  // incomplete expression after operator
+            }
+            uint32_t right = 0U;
+            if (!m_parseExpression(opPrecedence, right)) {
+                return false;
+            }
+            node = m_addOperator(op, node, right, 2U);
+        }
+        vNode = node;
+        return true;
+    }
 
-                while (pos < tokens.size() && tokens[pos].type == TokenType::SEPARATOR) {
-                    ++pos;
-                    if (node.childCount >= 3) {
-                        throw ExprException(ErrorCode::PARSE_ERROR, "Too many arguments provided for function: " + identifier);
+    // Same rules than Expr::m_parseFactor
+    constexpr bool m_parseFactor(uint32_t& vNode) {
+        if (m_Token.type == TokenType::Count) {
+            return m_fail(ErrorCode::PARSE_ERROR);  // unexpected end of expression
+        }
+        if (m_Token.type == TokenType::NUMBER) {
+            vNode                      = m_addNode(NodeType::NUMBER);
+            m_Tree.nodes[vNode].value  = m_Token.value;
+            m_next();
+            m_parsePostfix(vNode);
+        } else if (m_Token.type == TokenType::VARIABLE) {
+            const Token identifier = m_Token;
+            m_next();
+            if (m_Token.type == TokenType::LPAREN) {
+                const Builtins::Info* info = nullptr;
+                for (const auto& builtin : Builtins::s_Infos) {
+                    if (m_isName(identifier, builtin.name)) {
+                        info = &builtin;
                     }
-                    node.childs[node.childCount++] = ::std::make_shared<Node>(m_parseExpression(tokens, pos, 0));
                 }
-
-                if (pos >= tokens.size() || tokens[pos].type != TokenType::RPAREN) {
-                    throw ExprException(ErrorCode::UNMATCHED_PARENTHESIS, "Unmatched parenthesis");
+                if (info == nullptr) {
+                    m_Token = identifier;  // the error is reported at the name
+                    return m_fail(ErrorCode::FUNCTION_NOT_FOUND);
                 }
-                ++pos;
-
-                if (node.childCount != it->second.argCount) {
-                    throw ExprException(ErrorCode::FUNCTION_WRONG_ARGUMENTS_COUNT, "Incorrect number of arguments for function: " + identifier);
+                m_next();
+                if (m_Token.type == TokenType::RPAREN) {
+                    return m_fail(ErrorCode::FUNCTION_WRONG_ARGUMENTS_COUNT);
                 }
-
+                vNode                       = m_addNode(NodeType::FUNCTION);
+                m_Tree.nodes[vNode].builtin = info->id;
+                for (;;) {
+                    uint32_t child = 0U;
+                    if (!m_parseExpression(0, child)) {
+                        return false;
+                    }
+                    Node& node                   = m_Tree.nodes[vNode];
+                    node.childs[node.childCount++] = child;
+                    if (m_Token.type != TokenType::SEPARATOR) {
+                        break;
+                    }
+                    m_next();
+                    if (node.childCount >= 3U) {
+                        return m_fail(ErrorCode::PARSE_ERROR);  // too many arguments
+                    }
+                }
+                if (m_Token.type != TokenType::RPAREN) {
+                    return m_fail(ErrorCode::UNMATCHED_PARENTHESIS);
+                }
+                m_next();
+                if (m_Tree.nodes[vNode].childCount != info->argCount) {
+                    return m_fail(ErrorCode::FUNCTION_WRONG_ARGUMENTS_COUNT);
+                }
+                m_parsePostfix(vNode);
             } else {
-                // Gestion des variables (non-fonctions et non-constantes)
-                auto it = m_Constant.find(identifier);
-                if (it != m_Constant.end()) {
-                    node.type  = NodeType::NUMBER;
-                    node.value = it->second;
+                if (m_isName(identifier, "pi") || m_isName(identifier, "e")) {  // the constants of Expr::defineDefaultBuiltins
+                    vNode                     = m_addNode(NodeType::NUMBER);
+                    m_Tree.nodes[vNode].value = m_isName(identifier, "pi") ? M_PI : M_E;
                 } else {
-                    node.type                     = NodeType::VARIABLE;
-                    node.name                     = identifier;
-                    m_ParsedVariables[identifier] = 0.0;  // Ajout de la variable trouve avec une valeur par dfaut de 0.0
-                }
-
-                // Gestion de l'oprateur postfix "!" pour les variables
-                if (pos < tokens.size() && tokens[pos].type == TokenType::OPERATOR && tokens[pos].value == "!") {
-                    Node opNode;
-                    opNode.type       = NodeType::FUNCTION;
-                    opNode.name       = "!";
-                    opNode.childs[0]  = ::std::make_shared<Node>(node);
-                    opNode.childCount = 1;
-                    node              = opNode;  // Remplacer le nud par l'oprateur postfix
-                    ++pos;
+                    uint32_t slot = 0U;
+                    while (slot < m_Tree.varsCount && !m_isSameName(m_Tree.varsOffsets[slot], m_Tree.varsLengths[slot], identifier)) {
+                        ++slot;
+                    }
+                    if (slot == m_Tree.varsCount) {  // slots in order of first appearance, like Expr::m_assignVarSlots
+                        m_Tree.varsOffsets[slot] = identifier.offset;
+                        m_Tree.varsLengths[slot] = identifier.length;
+                        ++m_Tree.varsCount;
+                    }
+                    vNode                    = m_addNode(NodeType::VARIABLE);
+                    m_Tree.nodes[vNode].slot = slot;
                 }
+                m_parsePostfix(vNode);
             }
-        } else if (tokens[pos].type == TokenType::LPAREN) {
-            ++pos;
-            if (pos < tokens.size() && tokens[pos].type == TokenType::RPAREN) {
-                throw ExprException(ErrorCode::EMPTY_PARENTHESIS, "Empty parenthesis found");
+        } else if (m_Token.type == TokenType::LPAREN) {
+            m_next();
+            if (m_Token.type == TokenType::RPAREN) {
+                return m_fail(ErrorCode::EMPTY_PARENTHESIS);
             }
-            node = m_parseExpression(tokens, pos, 0);
-            if (pos >= tokens.size() || tokens[pos].type != TokenType::RPAREN) {
-                throw ExprException(ErrorCode::UNMATCHED_PARENTHESIS, "Unmatched parenthesis");
+            if (!m_parseExpression(0, vNode)) {
+                return false;
             }
-            ++pos;
-        } else if (tokens[pos].type == TokenType::OPERATOR) {
-            String op = tokens[pos].value;
-            if (op == "-") {
-                node.type = NodeType::FUNCTION;
-                node.name = tokens[pos].value;
-                ++pos;
-                node.childs[0]  = ::std::make_shared<Node>(m_parseFactor(tokens, pos));
-                node.childCount = 1;
-            } else if (op == "!") {
-                throw ExprException(ErrorCode::PARSE_ERROR, "Factorial operator '!' cannot be used alone or in prefix position.");
-            } else {
-                throw ExprException(ErrorCode::PARSE_ERROR, "Unexpected operator: " + tokens[pos].value);
+            if (m_Token.type != TokenType::RPAREN) {
+                return m_fail(ErrorCode::UNMATCHED_PARENTHESIS);
+            }
+            m_next();
+            m_parsePostfix(vNode);
+        } else if (m_Token.type == TokenType::OPERATOR && m_Token.op == OpCode::SUB) {
+            m_next();
+            uint32_t child = 0U;
+            if (!m_parseFactor(child)) {
+                return false;
             }
+            vNode = m_addOperator(OpCode::NEG, child, 0U, 1U);
         } else {
-            throw ExprException(ErrorCode::PARSE_ERROR, "Unexpected token: " + tokens[pos].value);
-        }
-
-        return node;
-    }
-
-    /////////////////////////////////////////
-    //// BUILTINS FUNCTIONS /////////////////
-    /////////////////////////////////////////
-
-    // Calculate a factorial
-    double m_Factorial(double vValue) {
-        if (vValue < 0 || ::std::floor(vValue) != vValue) {
-            throw ExprException(ErrorCode::PARSE_ERROR, "Factorial is not defined for negative or non-integer values.");
-        }
-        double result    = 1;
-        const auto count = static_cast<int>(vValue);
-        for (int i = 1; i <= count; ++i) {
-            result *= i;
-        }
-        return result;
-    }
-
-    // https://registry.khronos.org/OpenGL-Refpages/gl4/html/min.xhtml
-    double m_Min(double vX, double vY) {
-        if (vX < vY) {
-            return vX;
-        }
-        return vY;
-    }
-
-    // https://registry.khronos.org/OpenGL-Refpages/gl4/html/max.xhtml
-    double m_Max(double vX, double vY) {
-        if (vX > vY) {
-            return vX;
+            return m_fail(ErrorCode::PARSE_ERROR);  // unexpected token or operator
         }
-        return vY;
+        return true;
     }
+};
 
-    // https://www.shadertoy.com/???? : sqrt(v*v+k) with k >= 0
-    double m_SmoothAbs(double vV, double vK) {
-        return ::std::sqrt(vV * vV + ::std::abs(vK));
-    }
+// Parse an expression at compile time
+template <size_t tCapacity>
+constexpr Tree<tCapacity> parse(const char* vExpr) {
+    return Parser<tCapacity>(vExpr).parse();
+}
 
-    // https://registry.khronos.org/OpenGL-Refpages/gl4/html/clamp.xhtml
-    // Clamp (glsl), Saturate (hlsl)
-    double m_Clamp(double vX, double vMinVal, double vMaxVal) {
-        return m_Min(m_Max(vX, vMinVal), vMaxVal);
-    }
+// Functor evaluating an expression parsed at compile time, TSource::get() returning the expression
+// the arguments are the values of the variables in their order of first appearance in the expression
+template <typename TSource>
+class StaticExpr {
+public:
+    static constexpr auto s_Tree = parse<getLength(TSource::get()) + 1U>(TSource::get());
+    static_assert(s_Tree.error == ErrorCode::NONE, "EZ_EXPR : the expression can't be parsed, see ez::ct::StaticExpr::s_Tree for the error and its offset");
 
-    // https://registry.khronos.org/OpenGL-Refpages/gl4/html/smoothstep.xhtml
-    double m_SmoothStep(double vEdge0, double vEdge1, double vX) {
-        double t = m_Clamp((vX - vEdge0) / (vEdge1 - vEdge0), 0.0, 1.0);
-        return t * t * (3.0 - 2.0 * t);
+    // Returns the expression
+    static constexpr const char* getExpr() {
+        return TSource::get();
     }
 
-    // https://registry.khronos.org/OpenGL-Refpages/gl4/html/mix.xhtml
-    // Mix (glsl), lerp (hlsl)
-    double m_Mix(double vX, double vY, double vA) {
-        return vX * (1.0 - vA) + vY * vA;
+    // Returns the count of variables, so the count of arguments
+    static constexpr size_t getVarsCount() {
+        return s_Tree.varsCount;
     }
 
-    // https://registry.khronos.org/OpenGL-Refpages/gl4/html/step.xhtml
-    double m_Step(double vEdge, double vX) {
-        return vX < vEdge ? 0.0 : 1.0;
+    // Evaluate the expression, constexpr if it uses only operators and constexpr builtins
+    template <typename... TArgs>
+    constexpr double operator()(const TArgs... vArgs) const {
+        static_assert(sizeof...(TArgs) == s_Tree.varsCount, "EZ_EXPR : one argument is expected per variable, in their order of first appearance");
+        const double vars[sizeof...(TArgs) + 1U] = {static_cast<double>(vArgs)..., 0.0};
+        return m_eval<s_Tree.root>(vars);
     }
 
-    // https://registry.khronos.org/OpenGL-Refpages/gl4/html/sign.xhtml
-    double m_Sign(double vX) {
-        if (vX < 0.0) {
-            return -1.0;
-        } else if (vX > 0.0) {
-            return 1.0;
+private:
+    // Evaluate a node, the dispatch being done at compile time, like Expr::m_runChecked with ErrorCheckPolicy::NONE
+    template <uint32_t tIdx>
+    static constexpr double m_eval(const double* vVars) {
+        constexpr const Node& node = s_Tree.nodes[tIdx];
+        if constexpr (node.type == NodeType::NUMBER) {
+            return node.value;
+        } else if constexpr (node.type == NodeType::VARIABLE) {
+            return vVars[node.slot];
+        } else if constexpr (node.type == NodeType::FUNCTION && node.childCount == 1U) {
+            return Builtins::call<node.builtin>(m_eval<node.childs[0]>(vVars));
+        } else if constexpr (node.type == NodeType::FUNCTION && node.childCount == 2U) {
+            return Builtins::call<node.builtin>(m_eval<node.childs[0]>(vVars), m_eval<node.childs[1]>(vVars));
+        } else if constexpr (node.type == NodeType::FUNCTION) {
+            return Builtins::call<node.builtin>(m_eval<node.childs[0]>(vVars), m_eval<node.childs[1]>(vVars), m_eval<node.childs[2]>(vVars));
+        } else if constexpr (node.op == OpCode::NEG) {
+            return -m_eval<node.childs[0]>(vVars);
+        } else if constexpr (node.op == OpCode::FACTORIAL) {
+            return Builtins::call<BuiltinId::FACT>(m_eval<node.childs[0]>(vVars));
+        } else {
+            const double a = m_eval<node.childs[0]>(vVars);
+            const double b = m_eval<node.childs[1]>(vVars);
+            if constexpr (node.op == OpCode::ADD) {
+                return a + b;
+            } else if constexpr (node.op == OpCode::SUB) {
+                return a - b;
+            } else if constexpr (node.op == OpCode::MUL) {
+                return a * b;
+            } else if constexpr (node.op == OpCode::DIV) {
+                return a / b;
+            } else if constexpr (node.op == OpCode::POW) {
+                return ::std::pow(a, b);
+            } else {
+                static_assert(node.op == OpCode::MOD, "unknown operator");
+                return ::std::fmod(a, b);
+            }
         }
-        return 0.0;
     }
 };
 
+}  // namespace ct
+
+#endif  // USE_CONSTEXPR_PARSING
+
 }  // namespace ez
+
+#ifdef USE_CONSTEXPR_PARSING
+// Functor evaluating an expression parsed at compile time, ex: constexpr auto f = EZ_EXPR("x + 2.5 * d"); f(0.5, 1.5);
+#define EZ_EXPR(EXPR)                                        \
+    ([] {                                                    \
+        struct EzExprSource {                                \
+            static constexpr const char* get() {             \
+                return EXPR;                                 \
+            }                                                \
+        };                                                   \
+        return ::ez::ct::StaticExpr<EzExprSource>();         \
+    }())
+#endif  // USE_CONSTEXPR_PARSING
@@ -29,6 +29,16 @@ SOFTWARE.
 #include <EzExpr/constants/Test_Expr_Constants.h>
 #include <EzExpr/exceptions/Test_Expr_Exceptions.h>
 #include <EzExpr/perfos/Test_Expr_Perfos.h>
+#include <EzExpr/evaluations/Test_Expr_Evaluations.h>
+#include <EzExpr/variables/Test_Expr_Variables.h>
+#include <EzExpr/optimizations/Test_Expr_Optimizations.h>
+#include <EzExpr/batches/Test_Expr_Batches.h>
+#include <EzExpr/maths/Test_Expr_Maths.h>
+#include <EzExpr/contexts/Test_Expr_Contexts.h>
+#include <EzExpr/jits/Test_Expr_Jits.h>
+#include <EzExpr/generations/Test_Expr_Generations.h>
+#include <EzExpr/constexprs/Test_Expr_Constexprs.h>
+#include <EzExpr/caches/Test_Expr_Caches.h>
 
 ////////////////////////////////////////////////////////////////////////////
 //// ENTRY POINT ///////////////////////////////////////////////////////////
@@ -43,6 +53,16 @@ bool Test_Expr(const std::string& vTest) {
     else IfTestCollectionExist(Test_Expr_Builtins_run_test, "Test_Expr_Builtin");
     else IfTestCollectionExist(Test_Expr_Exceptions_run_test, "Test_Expr_Exception");
     else IfTestCollectionExist(Test_Expr_Perfos_run_test, "Test_Expr_Perfo");
+    else IfTestCollectionExist(Test_Expr_Evaluations_run_test, "Test_Expr_Evaluation");
+    else IfTestCollectionExist(Test_Expr_Variables_run_test, "Test_Expr_Variable");
+    else IfTestCollectionExist(Test_Expr_Optimizations_run_test, "Test_Expr_Optimization");
+    else IfTestCollectionExist(Test_Expr_Batches_run_test, "Test_Expr_Batch");
+    else IfTestCollectionExist(Test_Expr_Maths_run_test, "Test_Expr_Math");
+    else IfTestCollectionExist(Test_Expr_Contexts_run_test, "Test_Expr_Context");
+    else IfTestCollectionExist(Test_Expr_Jits_run_test, "Test_Expr_Jit");
+    else IfTestCollectionExist(Test_Expr_Generations_run_test, "Test_Expr_Generation");
+    else IfTestCollectionExist(Test_Expr_Constexprs_run_test, "Test_Expr_Constexpr");
+    else IfTestCollectionExist(Test_Expr_Caches_run_test, "Test_Expr_Cache");
     // default
     return false;
 }
\ No newline at end of file
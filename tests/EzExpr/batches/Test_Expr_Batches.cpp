@@ -0,0 +1,344 @@
+﻿/*
+MIT License
+
+Copyright (c) 2024 Stephane Cuillerdier (aka aiekick)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <EzExpr/batches/Test_Expr_Batches.h>
+#include <EzExpr.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+//// BATCHES ///////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+// compare each row of a batch with the evaluation of the same row
+// a relative tolerance is needed when the vectorized maths functions are used, InstructionSet::SCALAR being bit identical
+static bool checkRows(ez::Expr& vExpr, const std::vector<double>& vX, const std::vector<double>& vY, const std::vector<double>& vOut, const double vTolerance = 0.0) {
+    for (size_t row = 0; row < vOut.size(); ++row) {
+        const double expected = vExpr.set("x", vX[row]).set("y", vY[row]).eval().getResult();
+        if (std::abs(vOut[row] - expected) > vTolerance * std::abs(expected)) return false;
+    }
+    return true;
+}
+
+// the variables are read in columns, with a count of rows not multiple of the blocks size
+bool Test_Expr_Batch_Columns() {
+    const size_t count = 1000U;
+    std::vector<double> x(count), y(count), out(count);
+    for (size_t row = 0; row < count; ++row) {
+        x[row] = static_cast<double>(row) * 0.01;
+        y[row] = 3.0 - static_cast<double>(row) * 0.001;
+    }
+    ez::Expr ev;
+    ev.setInstructionSet(ez::InstructionSet::SCALAR).parse("x * y + sin(x) / (y ^ 2 + 1) - clamp(x, 0.5, 2) % 0.3 + 3!");
+    ev.evalBatch(count, {{"x", x.data()}, {"y", y.data()}}, out.data());
+    if (!checkRows(ev, x, y, out)) return false;
+    ev.setInstructionSet(ez::InstructionSet::AVX2);  // or the best supported, with the vectorized maths functions
+    ev.evalBatch(count, {{"x", x.data()}, {"y", y.data()}}, out.data());
+    return checkRows(ev, x, y, out, 1e-14);
+}
+
+// the columns can be given with the handles of the variables
+bool Test_Expr_Batch_Handles() {
+    const size_t count = 300U;
+    std::vector<double> x(count), y(count), out(count);
+    for (size_t row = 0; row < count; ++row) {
+        x[row] = static_cast<double>(row);
+        y[row] = static_cast<double>(row) * 0.5 + 1.0;
+    }
+    ez::Expr ev;
+    ev.parse("x / y - abs(x - y)");
+    ev.evalBatch(count, {{ev.getVarHandle("x"), x.data()}, {ev.getVarHandle("y"), y.data()}}, out.data());
+    return checkRows(ev, x, y, out);
+}
+
+// a variable without column keeps its single value
+bool Test_Expr_Batch_SingleValue() {
+    const double x[] = {1.0, 2.0, 3.0};
+    double out[3]    = {};
+    ez::Expr ev;
+    ev.parse("x * k").set("k", 10.0);
+    ev.evalBatch(3U, {{"x", x}, {"unknown", x}}, out);
+    return out[0] == 10.0 && out[1] == 20.0 && out[2] == 30.0;
+}
+
+// the shared subexpressions are reused in each row
+bool Test_Expr_Batch_SharedSubexpressions() {
+    const size_t count = 600U;
+    std::vector<double> x(count), y(count, 0.0), out(count);
+    for (size_t row = 0; row < count; ++row) {
+        x[row] = static_cast<double>(row) * 0.1 - 30.0;
+    }
+    ez::Expr ev;
+    ev.setInstructionSet(ez::InstructionSet::SCALAR).parse("sin(x) * 2 + 1 / (abs(sin(x) * 2) + 1) + y");
+    ev.evalBatch(count, {{"x", x.data()}, {"y", y.data()}}, out.data());
+    if (!checkRows(ev, x, y, out)) return false;
+    ev.setInstructionSet(ez::InstructionSet::AVX2);  // or the best supported, with the vectorized maths functions
+    ev.evalBatch(count, {{"x", x.data()}, {"y", y.data()}}, out.data());
+    return checkRows(ev, x, y, out, 1e-14);
+}
+
+// a variable without column nor value is reported
+bool Test_Expr_Batch_VariableNotFound() {
+    const double x[] = {1.0, 2.0};
+    double out[2]    = {};
+    ez::Expr ev;
+    ev.parse("x + y");
+    try {
+        ev.evalBatch(2U, {{"x", x}}, out);
+        return false;  // Expected an exception
+    } catch (const ez::ExprException& e) { return e.getCode() == ez::ErrorCode::VARIABLE_NOT_FOUND; }
+}
+
+// an error in any row is reported
+bool Test_Expr_Batch_DivisionByZero() {
+    std::vector<double> x(500U, 1.0), out(500U);
+    x[400] = 0.0;
+    ez::Expr ev;
+    ev.parse("1 / x");
+    try {
+        ev.evalBatch(x.size(), {{"x", x.data()}}, out.data());
+        return false;  // Expected an exception
+    } catch (const ez::ExprException& e) { return e.getCode() == ez::ErrorCode::DIVISION_BY_ZERO; }
+}
+
+// a batch without rows writes nothing
+bool Test_Expr_Batch_Empty() {
+    double out = 5.0;
+    ez::Expr ev;
+    ev.parse("x + 1");
+    ev.evalBatch(0U, {{"x", nullptr}}, &out);
+    return out == 5.0;
+}
+
+// the kernels of each instruction set give the same results than the evaluation row by row
+bool Test_Expr_Batch_InstructionSets() {
+    const size_t count = 1003U;  // not multiple of the registers width
+    std::vector<double> x(count), y(count), out(count);
+    for (size_t row = 0; row < count; ++row) {
+        x[row] = static_cast<double>(row % 37) * 0.25 - 4.0;
+        y[row] = static_cast<double>(row % 11) * 0.5 - 2.0;
+    }
+    x[5] = -0.0;
+    y[5] = -0.0;
+    ez::Expr ev;
+    ev.parse(
+        "min(x, y) + max(x, y) * step(x, y) - sign(x) + abs(y) + fract(x) + saturate(y) + clamp(x, -1, y) + mix(x, y, 0.3) + "
+        "lerp(y, x, 0.7) + smoothstep(-1, 2, x) + sqrt(abs(x)) / (1 + y * y) - -x");
+    const ez::InstructionSet sets[] = {ez::InstructionSet::SCALAR, ez::InstructionSet::SSE2, ez::InstructionSet::AVX2};
+    for (const auto set : sets) {
+        ev.setInstructionSet(set);
+        if (ev.getInstructionSet() > set) return false;
+        std::fill(out.begin(), out.end(), 0.0);
+        ev.evalBatch(count, {{"x", x.data()}, {"y", y.data()}}, out.data());
+        for (size_t row = 0; row < count; ++row) {
+            const double expected = ev.set("x", x[row]).set("y", y[row]).eval().getResult();
+            if (std::memcmp(&out[row], &expected, sizeof(double)) != 0) return false;  // bit identical
+        }
+    }
+    return true;
+}
+
+// an instruction set not supported is replaced by the best supported one
+bool Test_Expr_Batch_InstructionSetFallback() {
+    ez::Expr ev;
+    if (ev.getInstructionSet() != ez::simd::getBestInstructionSet()) return false;
+    ev.setInstructionSet(ez::InstructionSet::AVX2);
+    if (ev.getInstructionSet() != ez::simd::getBestInstructionSet()) return false;
+    ev.setInstructionSet(ez::InstructionSet::SCALAR);
+    return ev.getInstructionSet() == ez::InstructionSet::SCALAR;
+}
+
+// an Inf produced by a kernel is reported
+bool Test_Expr_Batch_KernelInf() {
+    std::vector<double> x(100U, 1e300), out(100U);
+    ez::Expr ev;
+    ev.parse("x * x");
+    try {
+        ev.evalBatch(x.size(), {{"x", x.data()}}, out.data());
+        return false;  // Expected an exception
+    } catch (const ez::ExprException& e) { return e.getCode() == ez::ErrorCode::EVALUATION_INF; }
+}
+
+// the rows split between the threads gives the same values than a single thread
+bool Test_Expr_Batch_Threads() {
+    const size_t count = 100003U;  // not multiple of the chunks size
+    std::vector<double> x(count), y(count), single(count), multi(count);
+    for (size_t row = 0; row < count; ++row) {
+        x[row] = static_cast<double>(row) * 0.001;
+        y[row] = static_cast<double>(row % 97) - 48.0;
+    }
+    ez::Expr ev;
+    ev.parse("sin(x) * y + sqrt(x) / (abs(y) + 1) + x % 3 + exp(-x)");
+    ev.evalBatch(count, {{"x", x.data()}, {"y", y.data()}}, single.data());
+    ev.setThreadsCount(7U);
+    if (ev.getThreadsCount() != 7U) return false;
+    ev.evalBatch(count, {{"x", x.data()}, {"y", y.data()}}, multi.data());
+    if (std::memcmp(single.data(), multi.data(), count * sizeof(double)) != 0) return false;
+    ev.setThreadsCount(1U);
+    return ev.getThreadsCount() == 1U;
+}
+
+// the error of the first row failing is reported by a parallel batch
+bool Test_Expr_Batch_ThreadsError() {
+    const size_t count = 50000U;
+    std::vector<double> x(count, 1.0), out(count);
+    x[count - 10U] = -2.0;  // NaN
+    x[20000U]      = 0.0;   // division by zero
+    ez::Expr ev;
+    ev.parse("sqrt(x) + 1 / x").setThreadsCount(4U);
+    try {
+        ev.evalBatch(count, {{"x", x.data()}}, out.data());
+    } catch (const ez::ExprException& e) {
+        return e.getCode() == ez::ErrorCode::DIVISION_BY_ZERO;
+    }
+    return false;
+}
+
+// the count of threads 0 is the count of hardware threads
+bool Test_Expr_Batch_ThreadsHardware() {
+    ez::Expr ev;
+    if (ev.getThreadsCount() != 1U) return false;
+    ev.setThreadsCount(0U);
+    return ev.getThreadsCount() == std::max<size_t>(std::thread::hardware_concurrency(), 1U);
+}
+
+// each task is executed once, by a thread in the range of the pool
+bool Test_Expr_Batch_ThreadPool() {
+    ez::ThreadPool pool(5U);
+    std::vector<size_t> done(1000U, 0U);
+    bool isWorkerValid = true;
+    for (size_t run = 0; run < 3U; ++run) {
+        if (pool.run(done.size(), [&done, &isWorkerValid](size_t vTask, size_t vWorker) {
+                ++done[vTask];
+                if (vWorker >= 5U) isWorkerValid = false;
+                return true;
+            }) != done.size()) return false;  // no failed task
+    }
+    return isWorkerValid && std::all_of(done.begin(), done.end(), [](size_t v) { return v == 3U; });
+}
+
+// the lowest failed task is returned, the tasks after it being skipped
+bool Test_Expr_Batch_ThreadPoolFailure() {
+    ez::ThreadPool pool(3U);
+    std::vector<std::atomic<size_t> > done(100U);
+    const size_t failedTask = pool.run(done.size(), [&done](size_t vTask, size_t) {
+        ++done[vTask];
+        return vTask != 40U && vTask != 70U;
+    });
+    if (failedTask != 40U) return false;
+    for (size_t idx = 0; idx <= 40U; ++idx) {
+        if (done[idx] != 1U) return false;  // the tasks before the failed one are all executed
+    }
+    return true;
+}
+
+// returns the error of the evaluation of a single row, like the one written by a batch evaluation with row errors
+static ez::ErrorCode getRowError(ez::Expr& vExpr, const double vX) {
+    double result = 0.0;
+    return vExpr.set("x", vX).tryEval(result);
+}
+
+// the error of each row is the one of its evaluation alone, and the other rows are evaluated
+bool Test_Expr_Batch_RowErrors() {
+    const size_t count = 10000U;
+    std::vector<double> x(count), out(count);
+    std::vector<ez::ErrorCode> errors(count, ez::ErrorCode::Count);
+    for (size_t idx = 0; idx < count; ++idx) {
+        x[idx] = static_cast<double>(idx % 7U) - 2.0;  // -2 .. 4
+    }
+    const ez::ErrorCheckPolicy policies[] = {ez::ErrorCheckPolicy::EVERY_NODE, ez::ErrorCheckPolicy::FINAL_RESULT, ez::ErrorCheckPolicy::STICKY_FLAGS, ez::ErrorCheckPolicy::NONE};
+    ez::Expr ev;
+    ev.parse("step(0, sqrt(x) + 1 / (x - 3)) + (x - 1) ^ 0.5");
+    for (size_t threads = 1U; threads <= 3U; threads += 2U) {
+        ev.setThreadsCount(threads);
+        for (const auto policy : policies) {
+            ev.setErrorCheckPolicy(policy);
+            if (ev.tryEvalBatch(count, {{"x", x.data()}}, out.data(), errors.data()) != ez::ErrorCode::NONE) return false;
+            for (size_t idx = 0; idx < 7U; ++idx) {
+                if (errors[count - 7U + idx] != getRowError(ev, x[count - 7U + idx])) return false;
+            }
+            if (policy == ez::ErrorCheckPolicy::NONE && !std::all_of(errors.begin(), errors.end(), [](ez::ErrorCode v) { return v == ez::ErrorCode::NONE; })) return false;
+        }
+    }
+    return out[count - 5U] == 1.0 + std::sqrt(3.0);  // x = 4, the rows after the failed ones are evaluated
+}
+
+// the errors of the rows are not thrown, only the ones not related to a row
+bool Test_Expr_Batch_RowErrors_Throw() {
+    std::vector<double> x = {1.0, 0.0, 2.0}, out(3U);
+    std::vector<ez::ErrorCode> errors(3U);
+    ez::Expr ev;
+    ev.parse("1 / x").evalBatch(3U, {{"x", x.data()}}, out.data(), errors.data());
+    if (errors[0] != ez::ErrorCode::NONE || errors[1] != ez::ErrorCode::DIVISION_BY_ZERO || errors[2] != ez::ErrorCode::NONE) return false;
+    if (out[0] != 1.0 || !std::isinf(out[1]) || out[2] != 0.5) return false;
+    try {
+        ev.parse("x + y").evalBatch(3U, {{"x", x.data()}}, out.data(), errors.data());
+        return false;  // Expected an exception
+    } catch (const ez::ExprException& e) { return e.getCode() == ez::ErrorCode::VARIABLE_NOT_FOUND; }
+}
+
+// the contexts write the errors of the rows too
+bool Test_Expr_Batch_RowErrors_Context() {
+    std::vector<double> x = {-1.0, 4.0, 1.5}, out(3U);
+    std::vector<ez::ErrorCode> errors(3U);
+    ez::Expr ev;
+    ev.parse("sqrt(x) + x!");
+    ez::EvalContext ctx(ev.compile());
+    if (ctx.tryEvalBatch(3U, {{"x", x.data()}}, out.data(), errors.data()) != ez::ErrorCode::NONE) return false;
+    return errors[0] == ez::ErrorCode::EVALUATION_NAN && errors[1] == ez::ErrorCode::NONE && errors[2] == ez::ErrorCode::PARSE_ERROR && out[1] == 26.0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//// ENTRY POINT ///////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+#define IfTestExist(v) \
+    if (vTest == std::string(#v)) return v()
+
+bool Test_Expr_Batches_run_test(const std::string& vTest) {
+    IfTestExist(Test_Expr_Batch_Columns);
+    else IfTestExist(Test_Expr_Batch_Handles);
+    else IfTestExist(Test_Expr_Batch_SingleValue);
+    else IfTestExist(Test_Expr_Batch_SharedSubexpressions);
+    else IfTestExist(Test_Expr_Batch_VariableNotFound);
+    else IfTestExist(Test_Expr_Batch_DivisionByZero);
+    else IfTestExist(Test_Expr_Batch_Empty);
+    else IfTestExist(Test_Expr_Batch_InstructionSets);
+    else IfTestExist(Test_Expr_Batch_InstructionSetFallback);
+    else IfTestExist(Test_Expr_Batch_KernelInf);
+    else IfTestExist(Test_Expr_Batch_Threads);
+    else IfTestExist(Test_Expr_Batch_ThreadsError);
+    else IfTestExist(Test_Expr_Batch_ThreadsHardware);
+    else IfTestExist(Test_Expr_Batch_ThreadPool);
+    else IfTestExist(Test_Expr_Batch_ThreadPoolFailure);
+    else IfTestExist(Test_Expr_Batch_RowErrors);
+    else IfTestExist(Test_Expr_Batch_RowErrors_Throw);
+    else IfTestExist(Test_Expr_Batch_RowErrors_Context);
+    // default
+    return false;
+}
\ No newline at end of file
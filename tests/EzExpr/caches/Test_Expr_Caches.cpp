@@ -0,0 +1,187 @@
+﻿/*
+MIT License
+
+Copyright (c) 2024 Stephane Cuillerdier (aka aiekick)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <EzExpr/caches/Test_Expr_Caches.h>
+#include <EzExpr.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+//// CACHES ////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+// the second parsing of an expression shares the tree of the first one
+bool Test_Expr_Cache_Hit() {
+    auto& cache = ez::ParseCache::get();
+    cache.clear();
+    ez::Expr ev1;
+    ez::Expr ev2;
+    ev1.setParseCaching(true).parse("x * y + 1");
+    ev2.setParseCaching(true).parse("x * y + 1");
+    if (cache.getMissesCount() != 1U || cache.getHitsCount() != 1U || cache.getSize() != 1U) return false;
+    if (ev2.getParsedVars().size() != 2U) return false;
+    if (!ev1.set("x", 2.0).set("y", 3.0).eval().check(7.0)) return false;
+    if (!ev2.set("x", 4.0).set("y", 0.5).eval().check(3.0)) return false;
+    ev2.setSimplification(ez::SimplificationMode::FAST);  // compiled again from the shared tree
+    return ev2.eval().check(3.0) && ev1.eval().check(7.0);
+}
+
+// the expressions parsed with other constants or functions don't share their tree
+bool Test_Expr_Cache_Registry() {
+    auto& cache = ez::ParseCache::get();
+    cache.clear();
+    ez::Expr ev1;
+    ez::Expr ev2;
+    ev1.setParseCaching(true).addConstant("k", 2.0).parse("k * x").set("x", 1.0);
+    ev2.setParseCaching(true).addConstant("k", 3.0).parse("k * x").set("x", 1.0);
+    if (cache.getMissesCount() != 2U || !ev1.eval().check(2.0) || !ev2.eval().check(3.0)) return false;
+    ev2.addConstant("k", 2.0).parse("k * x").set("x", 1.0);  // same constants than ev1 now
+    if (cache.getHitsCount() != 1U || !ev2.eval().check(2.0)) return false;
+    ev1.addFunction("f", [](double a) { return a * 2.0; }).parse("f(x)");
+    ev2.addFunction("f", [](double a, double b) { return a * b; });
+    if (ev2.tryParse("f(x)") != ez::ErrorCode::FUNCTION_WRONG_ARGUMENTS_COUNT) return false;
+    ev2.addFunction("f", [](double a) { return a * 4.0; }).parse("f(x)").set("x", 1.0);  // same tree, other functor
+    if (cache.getHitsCount() != 2U) return false;
+    return ev1.set("x", 1.0).eval().check(2.0) && ev2.eval().check(4.0);
+}
+
+// the least recently used tree is removed when the capacity is reached
+bool Test_Expr_Cache_Eviction() {
+    auto& cache = ez::ParseCache::get();
+    cache.clear();
+    cache.setCapacity(2U);
+    ez::Expr ev;
+    ev.setParseCaching(true);
+    ev.parse("x + 1").parse("x + 2").parse("x + 1").parse("x + 3");  // x + 2 removed
+    if (cache.getSize() != 2U || cache.getHitsCount() != 1U) return false;
+    ev.parse("x + 1");
+    if (cache.getHitsCount() != 2U) return false;
+    ev.parse("x + 2");
+    if (cache.getMissesCount() != 4U) return false;
+    cache.setCapacity(0U);
+    const bool isEmpty = (cache.getSize() == 0U);
+    cache.setCapacity(1024U);
+    return isEmpty && ev.set("x", 1.0).eval().check(3.0);
+}
+
+// the cache is shared by the threads, each one parsing with its own expression
+bool Test_Expr_Cache_Threads() {
+    auto& cache = ez::ParseCache::get();
+    cache.clear();
+    const size_t threadsCount = 8U;
+    const size_t parsingsCount = 500U;
+    std::atomic<bool> isOk(true);
+    std::vector<std::thread> threads;
+    for (size_t idx = 0; idx < threadsCount; ++idx) {
+        threads.emplace_back([&isOk, parsingsCount]() {
+            ez::Expr ev;
+            ev.setParseCaching(true);
+            for (size_t n = 0; n < parsingsCount; ++n) {
+                const double k = static_cast<double>(n % 10U);
+                ev.parse("x * " + std::to_string(n % 10U) + " + 1").set("x", 2.0);
+                if (!ev.eval().check(k * 2.0 + 1.0)) isOk = false;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (!isOk) return false;
+    if (cache.getHitsCount() + cache.getMissesCount() != threadsCount * parsingsCount) return false;
+    return cache.getSize() == 10U;
+}
+
+// the cache is not used by default, and the errors are not cached
+bool Test_Expr_Cache_Disabled() {
+    auto& cache = ez::ParseCache::get();
+    cache.clear();
+    ez::Expr ev;
+    ev.parse("x + 1").parse("x + 1");
+    if (cache.getHitsCount() != 0U || cache.getMissesCount() != 0U) return false;
+    ev.setParseCaching(true);
+    if (ev.tryParse("x +") == ez::ErrorCode::NONE || ev.tryParse("x +") == ez::ErrorCode::NONE) return false;
+    return cache.getSize() == 0U && cache.getMissesCount() == 2U;
+}
+
+// the program is shared by the expressions parsed with the same settings, not if it folded a user pure function
+bool Test_Expr_Cache_Program() {
+    auto& cache = ez::ParseCache::get();
+    cache.clear();
+    ez::Expr ev1;
+    ez::Expr ev2;
+    ez::Expr ev3;
+    ev1.setParseCaching(true).parse("x * (2 + 3) + sin(0)");
+    ev2.setParseCaching(true).parse("x * (2 + 3) + sin(0)");
+    if (cache.getHitsCount() != 1U || ev2.getProgram().code.size() != ev1.getProgram().code.size()) return false;
+    ev3.setParseCaching(true).setConstantFolding(false).parse("x * (2 + 3) + sin(0)");  // lowered again from the shared tree
+    if (cache.getHitsCount() != 2U || ev3.getProgram().code.size() <= ev1.getProgram().code.size()) return false;
+    if (!ev2.set("x", 2.0).eval().check(10.0) || !ev3.set("x", 2.0).eval().check(10.0)) return false;
+    ev1.addFunction("f", [](double a) { return a * 2.0; }, true).parse("f(3) + x").set("x", 1.0);
+    ev2.addFunction("f", [](double a) { return a * 4.0; }, true).parse("f(3) + x").set("x", 1.0);  // same tree, other folding
+    if (cache.getHitsCount() != 3U) return false;
+    return ev1.eval().check(7.0) && ev2.eval().check(13.0);
+}
+
+// the registries of the same fingerprint are compared in full
+bool Test_Expr_Cache_Collision() {
+    auto& cache = ez::ParseCache::get();
+    cache.clear();
+    ez::RegistrySnapshot::Entry constant;
+    constant.name = "k";
+    constant.value = 1U;
+    auto registry1 = std::make_shared<ez::RegistrySnapshot>();
+    registry1->entries.push_back(constant);
+    registry1->fingerprint = 42U;
+    auto registry2 = std::make_shared<ez::RegistrySnapshot>(*registry1);
+    registry2->entries[0].value = 2U;  // same fingerprint, other value
+    auto entry = std::make_shared<ez::ParseCacheEntry>();
+    entry->expr = "k * x";
+    entry->registry = registry1;
+    entry->tree = std::make_shared<ez::SyntaxTree>();
+    cache.insert(entry);
+    if (cache.find("k * x", registry2) != nullptr || cache.find("k * y", registry1) != nullptr) return false;
+    auto registry3 = std::make_shared<ez::RegistrySnapshot>(*registry1);  // equal, not the same address
+    return cache.find("k * x", registry3) == entry && cache.getHitsCount() == 1U && cache.getMissesCount() == 2U;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//// ENTRY POINT ///////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+#define IfTestExist(v) \
+    if (vTest == std::string(#v)) return v()
+
+bool Test_Expr_Caches_run_test(const std::string& vTest) {
+    IfTestExist(Test_Expr_Cache_Hit);
+    else IfTestExist(Test_Expr_Cache_Registry);
+    else IfTestExist(Test_Expr_Cache_Eviction);
+    else IfTestExist(Test_Expr_Cache_Threads);
+    else IfTestExist(Test_Expr_Cache_Disabled);
+    else IfTestExist(Test_Expr_Cache_Program);
+    else IfTestExist(Test_Expr_Cache_Collision);
+    // default
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+﻿/*
+MIT License
+
+Copyright (c) 2024 Stephane Cuillerdier (aka aiekick)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <EzExpr/constexprs/Test_Expr_Constexprs.h>
+#include <EzExpr.hpp>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+// this file is compiled in C++17, see tests/CMakeLists.txt
+
+////////////////////////////////////////////////////////////////////////////
+//// CONSTEXPRS ////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+// compare an expression parsed at compile time and the evaluation without checks, bit identical
+static bool CompareConstexpr(const char* vExpr, const std::function<double(double, double)>& vFunction) {
+    ez::Expr ev;
+    ev.setErrorCheckPolicy(ez::ErrorCheckPolicy::NONE).parse(vExpr);
+    for (double x = -2.0; x <= 2.0; x += 0.25) {
+        const double y        = 2.0 - x * 0.5;
+        const double expected = ev.set("x", x).set("y", y).eval().getResult();
+        const double result   = vFunction(x, y);
+        if (std::memcmp(&expected, &result, sizeof(double)) != 0) return false;  // bit identical, NaN included
+    }
+    return true;
+}
+
+// the expressions are evaluated at compile time when they use only operators
+bool Test_Expr_Constexpr_Constant() {
+    static_assert(EZ_EXPR("1 + 2 * 3")() == 7.0, "precedence");
+    static_assert(EZ_EXPR("-2^2")() == 4.0, "the prefix - applies to the factor");
+    static_assert(EZ_EXPR("2^3^2")() == 64.0, "^ is left associative");
+    static_assert(EZ_EXPR("(y - x) * y / 2")(3, 2) == 1.5, "variables in order of first appearance");
+    static_assert(EZ_EXPR("0.1 + 1e-3 + .5")() == 0.1 + 1e-3 + .5, "exact literals");
+    constexpr auto f = EZ_EXPR("x * x + d");
+    static_assert(f.getVarsCount() == 2U, "two variables");
+    static_assert(f(3, 0.5) == 9.5, "evaluated at compile time");
+    return std::string(f.getExpr()) == "x * x + d";
+}
+
+// the grammar is the one of the parsing at runtime
+bool Test_Expr_Constexpr_Grammar() {
+    if (!CompareConstexpr("x + y * 2.5 - x / y", [](double x, double y) { return EZ_EXPR("x + y * 2.5 - x / y")(x, y); })) return false;
+    if (!CompareConstexpr("-x^2 + -(-y) - 2^(-x)", [](double x, double y) { return EZ_EXPR("-x^2 + -(-y) - 2^(-x)")(x, y); })) return false;
+    if (!CompareConstexpr("x - y - 1 + x ^ y ^ 2", [](double x, double y) { return EZ_EXPR("x - y - 1 + x ^ y ^ 2")(x, y); })) return false;
+    if (!CompareConstexpr("  ( x+y ) *(x-y)%1.5 ", [](double x, double y) { return EZ_EXPR("  ( x+y ) *(x-y)%1.5 ")(x, y); })) return false;
+    if (!CompareConstexpr("4! + 3.5! + x! + fact(y)", [](double x, double y) { return EZ_EXPR("4! + 3.5! + x! + fact(y)")(x, y); })) return false;
+    if (!CompareConstexpr("(x + 3)! - (y)! + fact(4)!", [](double x, double y) { return EZ_EXPR("(x + 3)! - (y)! + fact(4)!")(x, y); })) return false;
+    if (!CompareConstexpr("pi * x + e * y + 1.5e2 + 2E-3 + 0.1", [](double x, double y) { return EZ_EXPR("pi * x + e * y + 1.5e2 + 2E-3 + 0.1")(x, y); })) return false;
+    return CompareConstexpr("x / 0 + y ^ 0.5", [](double x, double y) { return EZ_EXPR("x / 0 + y ^ 0.5")(x, y); });
+}
+
+// the builtins have the definitions of the runtime
+bool Test_Expr_Constexpr_Builtins() {
+    if (!CompareConstexpr("abs(x) + floor(x) + ceil(y) + round(x) + fract(y) + sign(x)", [](double x, double y) { return EZ_EXPR("abs(x) + floor(x) + ceil(y) + round(x) + fract(y) + sign(x)")(x, y); })) return false;
+    if (!CompareConstexpr("sin(x) + cos(y) + tan(x) + asin(x) + acos(y) + atan(x)", [](double x, double y) { return EZ_EXPR("sin(x) + cos(y) + tan(x) + asin(x) + acos(y) + atan(x)")(x, y); })) return false;
+    if (!CompareConstexpr("sinh(x) + cosh(y) + tanh(x) + asinh(x) + acosh(y) + atanh(x)", [](double x, double y) { return EZ_EXPR("sinh(x) + cosh(y) + tanh(x) + asinh(x) + acosh(y) + atanh(x)")(x, y); })) return false;
+    if (!CompareConstexpr("log(x) + ln(y) + log1p(x) + logb(y) + log2(y) + log10(y) + sqrt(x) + exp(y)", [](double x, double y) { return EZ_EXPR("log(x) + ln(y) + log1p(x) + logb(y) + log2(y) + log10(y) + sqrt(x) + exp(y)")(x, y); })) return false;
+    if (!CompareConstexpr("saturate(x) + mod(x, y) + pow(x, y) + atan2(x, y) + min(x, y) * max(x, y)", [](double x, double y) { return EZ_EXPR("saturate(x) + mod(x, y) + pow(x, y) + atan2(x, y) + min(x, y) * max(x, y)")(x, y); })) return false;
+    if (!CompareConstexpr("step(x, y) + hypot(x, y) + smoothabs(x, y) + clamp(x, -1, y)", [](double x, double y) { return EZ_EXPR("step(x, y) + hypot(x, y) + smoothabs(x, y) + clamp(x, -1, y)")(x, y); })) return false;
+    return CompareConstexpr("lerp(x, y, 0.25) + mix(y, x, 0.5) + smoothstep(-1, 1, x)", [](double x, double y) { return EZ_EXPR("lerp(x, y, 0.25) + mix(y, x, 0.5) + smoothstep(-1, 1, x)")(x, y); });
+}
+
+// the parsing errors are the ones of the runtime
+bool Test_Expr_Constexpr_Errors() {
+    const char* exprs[] = {"", "1 +", "(1 + 2", "1 + 2)", "()", "sin()", "sin(1, 2)", "min(1, 2, 3, 4)", "foo(1)", "2 ** 3", "2 *-3", "!3", "3! !", "(3)! !", "x y", ",", "1 + * 2", ".", "1e+"};
+    for (const auto& expr : exprs) {
+        ez::Expr ev;
+        const auto code = ev.tryParse(expr);
+        if (code == ez::ErrorCode::NONE) return false;
+        if (ez::ct::parse<32>(expr).error != code) return false;  // the parser can also run at runtime
+    }
+    return ez::ct::parse<32>("x + y").error == ez::ErrorCode::NONE;
+}
+
+// returns the number read by the parsing at runtime
+static double GetRuntimeNumber(const std::string& vLiteral) {
+    ez::Expr ev;
+    return ev.setErrorCheckPolicy(ez::ErrorCheckPolicy::NONE).parse(vLiteral).eval().getResult();  // Inf for a literal out of range
+}
+
+// the number literals are read to the same nearest double than the parsing at runtime
+bool Test_Expr_Constexpr_Numbers() {
+    constexpr double hard = EZ_EXPR("8.54693818e-199")();  // read at compile time
+    const double expected = GetRuntimeNumber("8.54693818e-199");
+    if (std::memcmp(&hard, &expected, sizeof(double)) != 0) return false;
+    std::vector<std::string> literals = {
+        "2.2250738585072011e-308", "2.2250738585072012e-308", "4.9406564584124654e-324", "2.4703282292062327e-324", "2.4703282292062328e-324",
+        "1.7976931348623157e308", "1.7976931348623158e308", "1.7976931348623159e308", "9007199254740993", "9007199254740992.500000000000000000001",
+        "0.1", "1e23", "8.98846567431158e307", "123456789012345678901234567890e-50", "1e-400", "1e400", "0.000000000000000000000000000000000123e10"};
+    std::string longLiteral = "1.";
+    for (int i = 0; i < 900; ++i) {
+        longLiteral += static_cast<char>('0' + (i * 7) % 10);  // more than the digits kept
+    }
+    literals.push_back(longLiteral + "e-300");
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+    for (int i = 0; i < 5000; ++i) {
+        std::string literal;
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        for (int digits = 1 + static_cast<int>((seed >> 33U) % 20U); digits > 0; --digits) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            literal += static_cast<char>('0' + (seed >> 33U) % 10U);
+        }
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        literal.insert(static_cast<size_t>(seed >> 33U) % literal.size(), ".");
+        literals.push_back(literal + "e" + std::to_string(static_cast<int>((seed >> 40U) % 660U) - 340));
+    }
+    for (const auto& literal : literals) {
+        const auto tree     = ez::ct::parse<8>(literal.c_str());  // the parser can also run at runtime
+        const double value  = tree.nodes[tree.root].value;
+        const double number = GetRuntimeNumber(literal);
+        if (tree.error != ez::ErrorCode::NONE || std::memcmp(&value, &number, sizeof(double)) != 0) return false;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//// ENTRY POINT ///////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+#define IfTestExist(v) \
+    if (vTest == std::string(#v)) return v()
+
+bool Test_Expr_Constexprs_run_test(const std::string& vTest) {
+    IfTestExist(Test_Expr_Constexpr_Constant);
+    else IfTestExist(Test_Expr_Constexpr_Grammar);
+    else IfTestExist(Test_Expr_Constexpr_Builtins);
+    else IfTestExist(Test_Expr_Constexpr_Errors);
+    else IfTestExist(Test_Expr_Constexpr_Numbers);
+    // default
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,158 @@
+﻿/*
+MIT License
+
+Copyright (c) 2024 Stephane Cuillerdier (aka aiekick)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <EzExpr/contexts/Test_Expr_Contexts.h>
+#include <EzExpr.hpp>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+//// CONTEXTS //////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+// a context gives the same result than the expression compiled
+bool Test_Expr_Context_Eval() {
+    ez::Expr ev;
+    ev.parse("x * y + sin(x) - clamp(y, 0, 1) + 3!");
+    auto compiled = ev.compile();
+    ez::EvalContext ctx(compiled);
+    for (double x = -2.0; x < 2.0; x += 0.25) {
+        const double expected = ev.set("x", x).set("y", x * 0.5).eval().getResult();
+        if (ctx.set("x", x).set("y", x * 0.5).eval().getResult() != expected) return false;
+    }
+    return compiled->getExpr() == ez::String("x * y + sin(x) - clamp(y, 0, 1) + 3!");
+}
+
+// the variables defined at the compilation are the default values of the contexts
+bool Test_Expr_Context_DefaultValues() {
+    ez::Expr ev;
+    ev.parse("x + k").set("k", 10.0);
+    ez::EvalContext ctx(ev.compile());
+    try {
+        ctx.eval();  // x not defined
+        return false;
+    } catch (const ez::ExprException& e) {
+        if (e.getCode() != ez::ErrorCode::VARIABLE_NOT_FOUND) return false;
+    }
+    if (ctx.set("x", 1.0).set("unknown", 5.0).eval().getResult() != 11.0) return false;
+    const auto k = ctx.getVarHandle("k");
+    return ctx.set(k, 20.0).eval().getResult() == 21.0;
+}
+
+// the compiled expression doesn't change with the expression
+bool Test_Expr_Context_Independent() {
+    auto ev = std::unique_ptr<ez::Expr>(new ez::Expr());
+    ev->addFunction("twice", [](double a) { return a * 2.0; });
+    ev->parse("twice(x) + k").set("k", 1.0);
+    auto compiled = ev->compile();
+    ev->set("k", 100.0);
+    ev->addFunction("twice", [](double a) { return a * 3.0; });
+    ev->parse("x");
+    ev.reset();  // the functions are copied in the compiled expression
+    ez::EvalContext ctx(compiled);
+    return ctx.set("x", 4.0).eval().getResult() == 9.0;
+}
+
+// many threads evaluates the same compiled expression, each one with its context
+bool Test_Expr_Context_Threads() {
+    ez::Expr ev;
+    ev.parse("x * x - sqrt(abs(x)) + cos(x) / (1 + x * x) + x * x");
+    auto compiled = ev.compile();
+    const size_t threadsCount = 8U;
+    const size_t count        = 10000U;
+    std::vector<double> expected(count);
+    for (size_t idx = 0; idx < count; ++idx) {
+        expected[idx] = ev.set("x", static_cast<double>(idx) * 0.01 - 50.0).eval().getResult();
+    }
+    std::vector<int> isValid(threadsCount, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadsCount; ++t) {
+        threads.emplace_back([&compiled, &expected, &isValid, count, t]() {
+            ez::EvalContext ctx(compiled);
+            const auto x = ctx.getVarHandle("x");
+            for (size_t idx = 0; idx < count; ++idx) {
+                if (ctx.set(x, static_cast<double>(idx) * 0.01 - 50.0).eval().getResult() != expected[idx]) return;
+            }
+            isValid[t] = 1;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto valid : isValid) {
+        if (valid == 0) return false;
+    }
+    return true;
+}
+
+// a context evaluates batches of rows like the expression
+bool Test_Expr_Context_Batch() {
+    const size_t count = 1000U;
+    std::vector<double> x(count), expected(count), out(count);
+    for (size_t row = 0; row < count; ++row) {
+        x[row] = static_cast<double>(row) * 0.1;
+    }
+    ez::Expr ev;
+    ev.parse("x * k + sqrt(x) + max(x, 50)").set("k", 3.0);
+    ev.evalBatch(count, {{"x", x.data()}}, expected.data());
+    ez::EvalContext ctx(ev.compile());
+    ctx.evalBatch(count, {{"x", x.data()}}, out.data());
+    if (std::memcmp(out.data(), expected.data(), count * sizeof(double)) != 0) return false;
+    std::fill(out.begin(), out.end(), 0.0);
+    ctx.evalBatch(count, {{ctx.getVarHandle("x"), x.data()}}, out.data());
+    return std::memcmp(out.data(), expected.data(), count * sizeof(double)) == 0;
+}
+
+// the errors of the evaluation are reported by the context
+bool Test_Expr_Context_Error() {
+    ez::Expr ev;
+    ev.parse("1 / x").set("x", 1.0);
+    ez::EvalContext ctx(ev.compile());
+    try {
+        ctx.set("x", 0.0).eval();
+    } catch (const ez::ExprException& e) {
+        return e.getCode() == ez::ErrorCode::DIVISION_BY_ZERO;
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//// ENTRY POINT ///////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+#define IfTestExist(v) \
+    if (vTest == std::string(#v)) return v()
+
+bool Test_Expr_Contexts_run_test(const std::string& vTest) {
+    IfTestExist(Test_Expr_Context_Eval);
+    else IfTestExist(Test_Expr_Context_DefaultValues);
+    else IfTestExist(Test_Expr_Context_Independent);
+    else IfTestExist(Test_Expr_Context_Threads);
+    else IfTestExist(Test_Expr_Context_Batch);
+    else IfTestExist(Test_Expr_Context_Error);
+    // default
+    return false;
+}
\ No newline at end of file
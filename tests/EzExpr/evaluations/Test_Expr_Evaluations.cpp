@@ -0,0 +1,192 @@
+﻿/*
+MIT License
+
+Copyright (c) 2024 Stephane Cuillerdier (aka aiekick)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <EzExpr/evaluations/Test_Expr_Evaluations.h>
+#include <EzExpr.hpp>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////
+//// EVALUATION ////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+// an expression not parsed evaluates to zero
+bool Test_Expr_Evaluation_NotParsed() {
+    ez::Expr ev;
+    return ev.eval().check(0.0);
+}
+
+// a long left associative chain keeps a small stack
+bool Test_Expr_Evaluation_LongChain() {
+    std::string expr = "1";
+    for (int i = 1; i < 1000; ++i) {
+        expr += " + 1";
+    }
+    ez::Expr ev;
+    return ev.parse(expr).eval().check(1000.0);
+}
+
+// a deep right nesting needs one stack value per level
+bool Test_Expr_Evaluation_DeepNesting() {
+    std::string expr;
+    for (int i = 0; i < 100; ++i) {
+        expr += "1 + (";
+    }
+    expr += "1";
+    for (int i = 0; i < 100; ++i) {
+        expr += ")";
+    }
+    ez::Expr ev;
+    return ev.parse(expr).eval().check(101.0);
+}
+
+// the operands order of the non commutative operators is kept
+bool Test_Expr_Evaluation_OperandsOrder() {
+    ez::Expr ev;
+    if (!ev.parse("10 - 4 - 3").eval().check(3.0)) return false;
+    if (!ev.parse("2 ^ 3 / 4").eval().check(2.0)) return false;
+    if (!ev.parse("clamp(5, 1, 3) - atan2(0, 1) + 7 % 4").eval().check(6.0)) return false;
+    return true;
+}
+
+// the program is reused between evaluations and rebuilt by a new parsing
+bool Test_Expr_Evaluation_Reparse() {
+    ez::Expr ev;
+    if (!ev.parse("x * 2").set("x", 3.0).eval().check(6.0)) return false;
+    if (!ev.set("x", 4.0).eval().check(8.0)) return false;
+    if (!ev.parse("x + y * 3").set("y", 2.0).eval().check(10.0)) return false;
+    if (!ev.parse("sin(0) + 5").eval().check(5.0)) return false;
+    return true;
+}
+
+// the same variable used many times in an expression
+bool Test_Expr_Evaluation_SameVariable() {
+    ez::Expr ev;
+    return ev.parse("a * a + a / a - a").set("a", 3.0).eval().check(7.0);
+}
+
+// a function replaced after the parsing is used by the next evaluation
+bool Test_Expr_Evaluation_FunctionReplaced() {
+    ez::Expr ev;
+    ev.addFunction("twice", [](double a) { return a * 2.0; });
+    if (!ev.parse("twice(x) + 1").set("x", 3.0).eval().check(7.0)) return false;
+    ev.addFunction("twice", [](double a) { return a + a + 1.0; });
+    if (!ev.eval().check(8.0)) return false;
+    return true;
+}
+
+// a function replaced after the parsing with another arity is reported at evaluation
+bool Test_Expr_Evaluation_FunctionReplacedArity() {
+    ez::Expr ev;
+    ev.addFunction("twice", [](double a) { return a * 2.0; });
+    ev.parse("twice(3)");
+    ev.addFunction("twice", [](double a, double b) { return a * b; });
+    try {
+        ev.eval();
+        return false;  // Expected an exception
+    } catch (const ez::ExprException& e) { return e.getCode() == ez::ErrorCode::FUNCTION_WRONG_ARGUMENTS_COUNT; }
+}
+
+// adding unrelated functions keeps the program valid
+bool Test_Expr_Evaluation_FunctionAdded() {
+    ez::Expr ev;
+    ev.parse("clamp(x, 0, 1) + sin(0)").set("x", 2.0);
+    if (!ev.eval().check(1.0)) return false;
+    for (int i = 0; i < 100; ++i) {
+        ev.addFunction(std::string("f") + std::to_string(i), [i](double a) { return a + i; });
+    }
+    if (!ev.eval().check(1.0)) return false;
+    return true;
+}
+
+// the prefix minus operator
+bool Test_Expr_Evaluation_UnaryMinus() {
+    ez::Expr ev;
+    if (!ev.parse("-(-3)").eval().check(3.0)) return false;
+    if (!ev.parse("2 * -3").eval().check(-6.0)) return false;
+    if (!ev.parse("-x + 1").set("x", 4.0).eval().check(-3.0)) return false;
+    return true;
+}
+
+// the postfix factorial operator
+bool Test_Expr_Evaluation_Factorial() {
+    ez::Expr ev;
+    if (!ev.parse("3! * 2").eval().check(12.0)) return false;
+    if (!ev.parse("n! + 1").set("n", 4.0).eval().check(25.0)) return false;
+    try {
+        ev.parse("(2 + 3)! 2").eval();
+        return false;  // Expected an exception
+    } catch (const ez::ExprException& e) { return e.getCode() == ez::ErrorCode::PARSE_ERROR; }
+}
+
+// the operators precedence
+bool Test_Expr_Evaluation_Precedence() {
+    ez::Expr ev;
+    if (!ev.parse("2 + 3 * 4").eval().check(14.0)) return false;
+    if (!ev.parse("2 * 3 ^ 2").eval().check(18.0)) return false;
+    if (!ev.parse("1 + 7 % 4 * 2").eval().check(7.0)) return false;
+    if (!ev.parse("8 / 2 - 6 / 3").eval().check(2.0)) return false;
+    return true;
+}
+
+// the verbose mode traces the evaluation only, not the nodes folded at parsing
+bool Test_Expr_Evaluation_Verbose() {
+    std::stringstream trace;
+    std::streambuf* coutBuffer = std::cout.rdbuf(trace.rdbuf());
+    ez::Expr ev;
+    ev.setVerbose(true).parse("x + 2 * 3");
+    const std::string parsing = trace.str();
+    ev.set("x", 1.0).eval();
+    std::cout.rdbuf(coutBuffer);
+    const std::string evaluation = trace.str().substr(parsing.size());
+    if (parsing.find("Evaluating Node") != std::string::npos) return false;
+    if (evaluation.find("Evaluating Node: 2\n") != std::string::npos) return false;  // 2 * 3 folded, only its result is pushed
+    return evaluation.find("Evaluating Node: 6\n") != std::string::npos && evaluation.find("Evaluating Node: 7\n") != std::string::npos;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//// ENTRY POINT ///////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+#define IfTestExist(v) \
+    if (vTest == std::string(#v)) return v()
+
+bool Test_Expr_Evaluations_run_test(const std::string& vTest) {
+    IfTestExist(Test_Expr_Evaluation_NotParsed);
+    else IfTestExist(Test_Expr_Evaluation_LongChain);
+    else IfTestExist(Test_Expr_Evaluation_DeepNesting);
+    else IfTestExist(Test_Expr_Evaluation_OperandsOrder);
+    else IfTestExist(Test_Expr_Evaluation_Reparse);
+    else IfTestExist(Test_Expr_Evaluation_SameVariable);
+    else IfTestExist(Test_Expr_Evaluation_FunctionReplaced);
+    else IfTestExist(Test_Expr_Evaluation_FunctionReplacedArity);
+    else IfTestExist(Test_Expr_Evaluation_FunctionAdded);
+    else IfTestExist(Test_Expr_Evaluation_UnaryMinus);
+    else IfTestExist(Test_Expr_Evaluation_Factorial);
+    else IfTestExist(Test_Expr_Evaluation_Precedence);
+    else IfTestExist(Test_Expr_Evaluation_Verbose);
+    // default
+    return false;
+}
\ No newline at end of file
@@ -25,6 +25,10 @@ SOFTWARE.
 
 #include <EzExpr/exceptions/Test_Expr_Exceptions.h>
 #include <EzExpr.hpp>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
 
 ////////////////////////////////////////////////////////////////////////////
 //// ERROR CODES ///////////////////////////////////////////////////////////
@@ -163,6 +167,159 @@ bool Test_Expr_Exception_EvaluationInf_Power() {
     } catch (const ez::ExprException& e) { return e.getCode() == ez::ErrorCode::EVALUATION_INF; }
 }
 
+////////////////////////////////////////////////////////////////////////////
+//// ERROR CHECK POLICIES //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+// returns the error code thrown by the evaluation, or ErrorCode::NONE
+static ez::ErrorCode getEvalError(ez::Expr& vExpr) {
+    try {
+        vExpr.eval();
+    } catch (const ez::ExprException& e) { return e.getCode(); }
+    return ez::ErrorCode::NONE;
+}
+
+// with FINAL_RESULT the errors of the intermediate nodes are not reported
+bool Test_Expr_Exception_ErrorCheck_FinalResult() {
+    ez::Expr ev;
+    ev.parse("step(0, 1 / x)").set("x", 0.0);
+    if (getEvalError(ev) != ez::ErrorCode::DIVISION_BY_ZERO) return false;
+    ev.setErrorCheckPolicy(ez::ErrorCheckPolicy::FINAL_RESULT);
+    if (getEvalError(ev) != ez::ErrorCode::NONE || ev.getResult() != 1.0) return false;
+    ev.parse("sqrt(x)").set("x", -1.0);  // the policy is kept by the parsing
+    return ev.getErrorCheckPolicy() == ez::ErrorCheckPolicy::FINAL_RESULT && getEvalError(ev) == ez::ErrorCode::EVALUATION_NAN;
+}
+
+// with STICKY_FLAGS the errors of the intermediate nodes are reported at the end
+bool Test_Expr_Exception_ErrorCheck_StickyFlags() {
+    ez::Expr ev;
+    ev.setErrorCheckPolicy(ez::ErrorCheckPolicy::STICKY_FLAGS);
+    ev.parse("step(0, 1 / x)").set("x", 0.0);
+    if (getEvalError(ev) != ez::ErrorCode::DIVISION_BY_ZERO) return false;
+    ev.parse("step(0, sqrt(x))").set("x", -1.0);
+    if (getEvalError(ev) != ez::ErrorCode::EVALUATION_NAN) return false;
+    ev.parse("x ^ 0.5").set("x", -4.0);
+    if (getEvalError(ev) != ez::ErrorCode::EVALUATION_NAN) return false;
+    ev.set("x", 4.0);
+    return getEvalError(ev) == ez::ErrorCode::NONE && ev.getResult() == 2.0;
+}
+
+// with NONE the result can be NaN or Inf
+bool Test_Expr_Exception_ErrorCheck_None() {
+    ez::Expr ev;
+    ev.setErrorCheckPolicy(ez::ErrorCheckPolicy::NONE);
+    ev.parse("1 / x").set("x", 0.0);
+    if (getEvalError(ev) != ez::ErrorCode::NONE || !std::isinf(ev.getResult())) return false;
+    ev.parse("x % 0").set("x", 2.0);  // not folded, so it is evaluated
+    return getEvalError(ev) == ez::ErrorCode::NONE && std::isnan(ev.getResult());
+}
+
+// the batch evaluation follows the policy, the sticky flags being checked after the last row
+bool Test_Expr_Exception_ErrorCheck_Batch() {
+    const size_t count = 1000U;
+    std::vector<double> x(count, 2.0), out(count);
+    x[700U] = 0.0;
+    const ez::ErrorCheckPolicy policies[]  = {ez::ErrorCheckPolicy::EVERY_NODE, ez::ErrorCheckPolicy::FINAL_RESULT, ez::ErrorCheckPolicy::STICKY_FLAGS, ez::ErrorCheckPolicy::NONE};
+    const ez::ErrorCode expectedErrors[] = {ez::ErrorCode::DIVISION_BY_ZERO, ez::ErrorCode::NONE, ez::ErrorCode::DIVISION_BY_ZERO, ez::ErrorCode::NONE};
+    ez::Expr ev;
+    ev.parse("step(0, 1 / x) + x");
+    for (size_t idx = 0; idx < 4U; ++idx) {
+        ev.setErrorCheckPolicy(policies[idx]);
+        std::fill(out.begin(), out.end(), 0.0);
+        ez::ErrorCode error = ez::ErrorCode::NONE;
+        try {
+            ev.evalBatch(count, {{"x", x.data()}}, out.data());
+        } catch (const ez::ExprException& e) { error = e.getCode(); }
+        if (error != expectedErrors[idx]) return false;
+        if (policies[idx] != ez::ErrorCheckPolicy::EVERY_NODE && (out[700U] != 1.0 || out[count - 1U] != 3.0)) return false;
+    }
+    return true;
+}
+
+// the compiled expressions keeps the policy
+bool Test_Expr_Exception_ErrorCheck_Context() {
+    ez::Expr ev;
+    ev.parse("step(0, 1 / x)").set("x", 0.0).setErrorCheckPolicy(ez::ErrorCheckPolicy::FINAL_RESULT);
+    ez::EvalContext ctx(ev.compile());
+    return ctx.eval().getResult() == 1.0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//// ERRORS AS VALUES //////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+// tryParse returns the code of the exception thrown by parse, and the expression not parsed evaluates to 0.0
+bool Test_Expr_Exception_TryParse() {
+    ez::Expr ev;
+    if (ev.tryParse("x + 1") != ez::ErrorCode::NONE || ev.getError().code != ez::ErrorCode::NONE) return false;
+    if (ev.tryParse("1 + (2 * 3") != ez::ErrorCode::UNMATCHED_PARENTHESIS) return false;
+    if (ev.getError().code != ez::ErrorCode::UNMATCHED_PARENTHESIS || ev.getError().message.length() == 0U) return false;
+    if (ev.tryParse("unknownFunc(1)") != ez::ErrorCode::FUNCTION_NOT_FOUND) return false;
+    if (ev.tryParse("sin(1, 2)") != ez::ErrorCode::FUNCTION_WRONG_ARGUMENTS_COUNT) return false;
+    if (ev.tryParse("()") != ez::ErrorCode::EMPTY_PARENTHESIS) return false;
+    if (ev.tryParse("3 ! 2") != ez::ErrorCode::PARSE_ERROR) return false;
+    double result = -1.0;
+    return ev.tryEval(result) == ez::ErrorCode::NONE && result == 0.0 && ev.getParsedVars().empty();
+}
+
+// tryEval returns the code of the exception thrown by eval, the result being kept on error
+bool Test_Expr_Exception_TryEval() {
+    ez::Expr ev;
+    double result = -1.0;
+    if (ev.parse("x + 1").tryEval(result) != ez::ErrorCode::VARIABLE_NOT_FOUND || result != -1.0) return false;
+    if (std::string(ev.getError().message.c_str()) != "Variable not found: x") return false;
+    ev.parse("1 / x").set("x", 0.0);
+    if (ev.tryEval(result) != ez::ErrorCode::DIVISION_BY_ZERO || result != -1.0) return false;
+    ev.set("x", 2.0);
+    if (ev.tryEval(result) != ez::ErrorCode::NONE || result != 0.5 || ev.getResult() != 0.5) return false;
+    return ev.getError().code == ez::ErrorCode::NONE && ev.getError().message.length() == 0U;
+}
+
+// the builtins pow and fact report their domain errors like the operators
+bool Test_Expr_Exception_TryEval_Builtins() {
+    ez::Expr ev;
+    double result = 0.0;
+    if (ev.parse("pow(x, 2)").set("x", -2.0).tryEval(result) != ez::ErrorCode::EVALUATION_NAN) return false;
+    if (ev.parse("fact(x)").set("x", -1.0).tryEval(result) != ez::ErrorCode::PARSE_ERROR) return false;
+    if (ev.parse("x!").tryEval(result) != ez::ErrorCode::PARSE_ERROR) return false;
+    if (ev.set("x", 4.0).tryEval(result) != ez::ErrorCode::NONE || result != 24.0) return false;
+    ev.setErrorCheckPolicy(ez::ErrorCheckPolicy::NONE).set("x", 2.5);
+    return ev.tryEval(result) == ez::ErrorCode::NONE && std::isnan(result);
+}
+
+// the batch evaluation reports the error of the first failed row, with one or several threads
+bool Test_Expr_Exception_TryEvalBatch() {
+    const size_t count = 20000U;
+    std::vector<double> x(count, 2.0), out(count, 0.0);
+    x[15000U] = 0.0;
+    x[9000U]  = 0.0;
+    ez::Expr ev;
+    ev.parse("1 / x + y").set("y", 1.0);
+    for (size_t threads = 1U; threads <= 4U; threads += 3U) {
+        ev.setThreadsCount(threads);
+        if (ev.tryEvalBatch(count, {{"x", x.data()}}, out.data()) != ez::ErrorCode::DIVISION_BY_ZERO) return false;
+        if (out[0] != 1.5) return false;  // the rows before the first failed block are evaluated
+    }
+    x[15000U] = 2.0;
+    x[9000U]  = 2.0;
+    if (ev.tryEvalBatch(count, {{"x", x.data()}}, out.data()) != ez::ErrorCode::NONE) return false;
+    return ev.getError().code == ez::ErrorCode::NONE && out[count - 1U] == 1.5;
+}
+
+// the contexts of a compiled expression have the same functions not throwing
+bool Test_Expr_Exception_TryEvalContext() {
+    ez::Expr ev;
+    ev.parse("sqrt(x) + y");
+    ez::EvalContext ctx(ev.compile());
+    double result = 0.0;
+    if (ctx.set("x", 4.0).tryEval(result) != ez::ErrorCode::VARIABLE_NOT_FOUND) return false;
+    if (std::string(ctx.getError().message.c_str()) != "Variable not found: y") return false;
+    if (ctx.set("y", 1.0).tryEval(result) != ez::ErrorCode::NONE || result != 3.0) return false;
+    std::vector<double> x = {4.0, -1.0}, out(2U);
+    if (ctx.tryEvalBatch(2U, {{"x", x.data()}}, out.data()) != ez::ErrorCode::EVALUATION_NAN) return false;
+    return ctx.getError().code == ez::ErrorCode::EVALUATION_NAN && ctx.getResult() == 3.0;
+}
+
 ////////////////////////////////////////////////////////////////////////////
 //// ENTRY POINT ///////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////
@@ -188,6 +345,16 @@ bool Test_Expr_Exceptions_run_test(const std::string& vTest) {
     else IfTestExist(Test_Expr_Exception_EvaluationInf);
     else IfTestExist(Test_Expr_Exception_EvaluationInf_Exp);
     else IfTestExist(Test_Expr_Exception_EvaluationInf_Power);
+    else IfTestExist(Test_Expr_Exception_ErrorCheck_FinalResult);
+    else IfTestExist(Test_Expr_Exception_ErrorCheck_StickyFlags);
+    else IfTestExist(Test_Expr_Exception_ErrorCheck_None);
+    else IfTestExist(Test_Expr_Exception_ErrorCheck_Batch);
+    else IfTestExist(Test_Expr_Exception_ErrorCheck_Context);
+    else IfTestExist(Test_Expr_Exception_TryParse);
+    else IfTestExist(Test_Expr_Exception_TryEval);
+    else IfTestExist(Test_Expr_Exception_TryEval_Builtins);
+    else IfTestExist(Test_Expr_Exception_TryEvalBatch);
+    else IfTestExist(Test_Expr_Exception_TryEvalContext);
     // default
     return false;
 }
\ No newline at end of file
@@ -0,0 +1,122 @@
+﻿/*
+MIT License
+
+Copyright (c) 2024 Stephane Cuillerdier (aka aiekick)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <EzExpr/generations/Test_Expr_Generations.h>
+#include <Test_Expr_Generated.h>
+#include <EzExpr.hpp>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////
+//// GENERATIONS ///////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+// the source of a function with the variables as arguments
+bool Test_Expr_Generation_Source() {
+    ez::Expr ev;
+    ev.parse("x * x + d");
+    const std::string expected =
+        "// x * x + d\n"
+        "inline double poly(double x, double d) {\n"
+        "    const double ez_r0 = x * x;\n"
+        "    const double ez_r1 = ez_r0 + d;\n"
+        "    return ez_r1;\n"
+        "}\n";
+    if (ev.toCppSource("poly").to_string() != expected) return false;
+    ev.parse("1 + 2");  // folded
+    return ev.toCppSource("three").to_string() == "// 1 + 2\ninline double three() {\n    return 3.0;\n}\n";
+}
+
+// the functions added by the user are called by their name, the simplifications are kept
+bool Test_Expr_Generation_Functions() {
+    ez::Expr ev;
+    ev.addFunction("twice", [](double a) { return a * 2.0; });
+    ev.setSimplification(ez::SimplificationMode::FAST).parse("twice(y) + y ^ 3");
+    const std::string src = ev.toCppSource("f").to_string();
+    if (src.find("inline double f(double y) {") == std::string::npos) return false;
+    if (src.find("= twice(y);") == std::string::npos) return false;
+    if (src.find("*= ez_r") == std::string::npos) return false;  // y^3 as multiplications
+    ev.setSimplification(ez::SimplificationMode::NONE).parse("y * -0");
+    return ev.toCppSource("f").to_string().find("y * (-0.0);") != std::string::npos;  // the sign of the zero is kept
+}
+
+// the functions generated by EzExprToCpp give the results of the evaluation without checks
+bool Test_Expr_Generation_Compiled() {
+    struct Generated {
+        const char* expr;
+        std::function<double(double, double)> function;
+    };
+    const Generated generated[] = {
+        {"x * x + 2.5 * d", [](double x, double d) { return gen_poly(x, d); }},
+        {"clamp(x, -1, 1) + smoothstep(0, 1, d) + min(x, d) * max(x, d) + step(0.5, x) + lerp(x, d, 0.25) + saturate(d) + sign(x) + fract(d)", [](double x, double d) { return gen_builtins(x, d); }},
+        {"sin(x) * cos(d) + atan2(x, d) + hypot(x, d) + smoothabs(x, d) + exp(d) - ln(abs(x) + 1) + floor(x) * ceil(d) + round(x)", [](double x, double d) { return gen_maths(x, d); }},
+        {"x ^ 2 + abs(x) ^ 0.5 + pow(abs(d), 1.5) + 4! + d! + (x * d) % 1.5 + mod(x, 0.75)", [](double x, double d) { return gen_powers(x, d); }},
+        {"(x * d + 1) * (x * d + 1) / (x * d + 1) - -x", [](double x, double d) { return gen_shared(x, d); }},
+        {"2 * pi * x + e - 1e-3", [](double x, double) { return gen_folded(x); }},
+        {"1 / x + sqrt(x) + ln(d)", [](double x, double d) { return gen_errors(x, d); }},
+    };
+    for (const auto& gen : generated) {
+        ez::Expr ev;
+        ev.setErrorCheckPolicy(ez::ErrorCheckPolicy::NONE).parse(gen.expr);
+        for (double x = -2.0; x <= 2.0; x += 0.25) {
+            const double d        = 2.0 - x * 0.5;
+            const double expected = ev.set("x", x).set("d", d).eval().getResult();
+            const double result   = gen.function(x, d);
+            if (std::memcmp(&expected, &result, sizeof(double)) != 0) return false;  // bit identical, NaN included
+        }
+    }
+    return true;
+}
+
+// the variables named like C++ keywords or macros are renamed, the order of the arguments being kept
+bool Test_Expr_Generation_Reserved() {
+    ez::Expr ev;
+    ev.setErrorCheckPolicy(ez::ErrorCheckPolicy::NONE).parse("new * 2 + int - i! + NAN");
+    const std::string src = ev.toCppSource("f").to_string();
+    if (src.find("inline double f(double new_, double int_, double i, double NAN_) {") == std::string::npos) return false;
+    for (double i = 0.0; i <= 4.0; i += 0.5) {
+        const double expected = ev.set("new", i * 3.0).set("int", -i).set("i", i).set("NAN", 0.25).eval().getResult();
+        const double result   = gen_reserved(i * 3.0, -i, i, 0.25);  // compiled from Test_Expr_Generations.txt
+        if (std::memcmp(&expected, &result, sizeof(double)) != 0) return false;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//// ENTRY POINT ///////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+#define IfTestExist(v) \
+    if (vTest == std::string(#v)) return v()
+
+bool Test_Expr_Generations_run_test(const std::string& vTest) {
+    IfTestExist(Test_Expr_Generation_Source);
+    else IfTestExist(Test_Expr_Generation_Functions);
+    else IfTestExist(Test_Expr_Generation_Compiled);
+    else IfTestExist(Test_Expr_Generation_Reserved);
+    // default
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+﻿/*
+MIT License
+
+Copyright (c) 2024 Stephane Cuillerdier (aka aiekick)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <EzExpr/jits/Test_Expr_Jits.h>
+#include <EzExpr.hpp>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+//// JITS //////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+// compare the native code and the interpreter on an expression, the results and the errors must be the same
+static bool CompareJit(const std::string& vExpr, ez::ErrorCheckPolicy vPolicy) {
+    ez::Expr ev;
+    ez::Expr evJit;
+    ev.setErrorCheckPolicy(vPolicy).parse(vExpr);
+    evJit.setErrorCheckPolicy(vPolicy).setJitCompilation(true).parse(vExpr);
+#ifdef USE_JIT
+    if (!evJit.isJitCompiled()) return false;
+#endif  // USE_JIT
+    for (double x = -3.0; x <= 3.0; x += 0.25) {
+        double result = 0.0, resultJit = 0.0;
+        const auto code    = ev.set("x", x).set("y", x * 0.5 + 1.0).tryEval(result);
+        const auto codeJit = evJit.set("x", x).set("y", x * 0.5 + 1.0).tryEval(resultJit);
+        if (code != codeJit) return false;
+        if (std::memcmp(&result, &resultJit, sizeof(double)) != 0) return false;  // bit identical, NaN included
+    }
+    return true;
+}
+
+// the native code gives the same results than the interpreter
+bool Test_Expr_Jit_Results() {
+    const char* exprs[] = {
+        "x * x + y",
+        "x - y * 2.5 / (y + 10)",
+        "-x + -(-y)",
+        "(x + 1)^3 + 2^y",
+        "sqrt(abs(x)) + min(x, y) * max(x, -y)",
+        "sin(x) * cos(y) + atan2(x, y)",
+        "clamp(x, -1, 1) + lerp(x, y, 0.25) + smoothstep(0, 1, y)",
+        "x % 1.5 + 4! + fact(3)",
+        "(x * y + 1) * (x * y + 1) - (x * y + 1)",
+        "floor(x) + ceil(y) + round(x * y) + fract(x)",
+        "pi * e + 1e300 * 1e300 * 0",
+    };
+    const ez::ErrorCheckPolicy policies[] = {ez::ErrorCheckPolicy::EVERY_NODE, ez::ErrorCheckPolicy::FINAL_RESULT, ez::ErrorCheckPolicy::STICKY_FLAGS, ez::ErrorCheckPolicy::NONE};
+    for (const auto& expr : exprs) {
+        for (const auto& policy : policies) {
+            if (!CompareJit(expr, policy)) return false;
+        }
+    }
+    return true;
+}
+
+// the errors are reported by the interpreter, with the same codes
+bool Test_Expr_Jit_Errors() {
+    const char* exprs[] = {
+        "1 / (x - 1)",
+        "x % (y - 1)",
+        "x ^ 0.5",
+        "pow(x, 1.5)",
+        "sqrt(x)",
+        "ln(x)",
+        "x! + 1",
+        "1e308 * (x + 3)",
+    };
+    const ez::ErrorCheckPolicy policies[] = {ez::ErrorCheckPolicy::EVERY_NODE, ez::ErrorCheckPolicy::FINAL_RESULT, ez::ErrorCheckPolicy::STICKY_FLAGS, ez::ErrorCheckPolicy::NONE};
+    for (const auto& expr : exprs) {
+        for (const auto& policy : policies) {
+            if (!CompareJit(expr, policy)) return false;
+        }
+    }
+    ez::Expr ev;
+    ev.setJitCompilation(true).parse("x + z").set("x", 1.0);
+    double result = 5.0;
+    if (ev.tryEval(result) != ez::ErrorCode::VARIABLE_NOT_FOUND || result != 5.0) return false;
+    if (ev.set("z", 2.0).tryEval(result) != ez::ErrorCode::NONE || result != 3.0) return false;
+    ev.setErrorCheckPolicy(ez::ErrorCheckPolicy::NONE).parse("1 / x").set("x", 0.0);
+    if (ev.tryEval(result) != ez::ErrorCode::NONE || !std::isinf(result)) return false;
+    ev.setErrorCheckPolicy(ez::ErrorCheckPolicy::EVERY_NODE);  // the checks are compiled again
+    return ev.tryEval(result) == ez::ErrorCode::DIVISION_BY_ZERO;
+}
+
+// the registered functions are called, the values of the stack being kept during the calls
+bool Test_Expr_Jit_Functions() {
+    int calls = 0;
+    ez::Expr ev;
+    ev.setJitCompilation(true);
+    ev.addFunction("f1", [&calls](double a) { ++calls; return a * 2.0; });
+    ev.addFunction("f2", [](double a, double b) { return a - b; });
+    ev.addFunction("f3", [](double a, double b, double c) { return a * b + c; });
+    ev.parse("x + (y * (x - (y + f3(x, f2(y, f1(x)), f1(y)))))");
+    const double x = 1.5, y = -0.75;
+    const double expected = x + (y * (x - (y + ((x * (y - x * 2.0)) + y * 2.0))));
+    if (ev.set("x", x).set("y", y).eval().getResult() != expected || calls != 2) return false;
+    ev.addFunction("f1", [](double a) { return a * 4.0; });  // compiled again at the evaluation
+    const double expected4 = x + (y * (x - (y + ((x * (y - x * 4.0)) + y * 4.0))));
+    if (ev.eval().getResult() != expected4) return false;
+#ifdef USE_EXCEPTIONS
+    ev.addFunction("fail", [](double a) -> double {
+        if (a > 1.0) throw ez::ExprException(ez::ErrorCode::EVALUATION_NAN, "fail");
+        return a;
+    });
+    ev.parse("x * 2 + fail(x)").set("x", 2.0);
+    try {
+        ev.eval();
+        return false;
+    } catch (const ez::ExprException& e) {
+        if (e.getCode() != ez::ErrorCode::EVALUATION_NAN) return false;
+    }
+    if (ev.set("x", 0.5).eval().getResult() != 1.5) return false;
+#endif  // USE_EXCEPTIONS
+    return true;
+}
+
+// a stack deeper than the registers is evaluated by the interpreter
+bool Test_Expr_Jit_DeepStack() {
+    std::string expr = "x";
+    for (int i = 0; i < 20; ++i) {
+        expr = "(x + " + std::to_string(i) + " * " + expr + ")";
+    }
+    ez::Expr ev;
+    ez::Expr evJit;
+    ev.setConstantFolding(false).parse(expr);
+    evJit.setConstantFolding(false).setJitCompilation(true).parse(expr);
+    if (evJit.isJitCompiled()) return false;
+    return ev.set("x", 0.5).eval().getResult() == evJit.set("x", 0.5).eval().getResult();
+}
+
+// the contexts of an expression compiled with the jit use the native code
+bool Test_Expr_Jit_Context() {
+    ez::Expr ev;
+    ev.addFunction("twice", [](double a) { return a * 2.0; });
+    ev.setJitCompilation(true).parse("twice(x) * y + 1 / x").set("y", 3.0);
+    auto compiled = ev.compile();
+    ev.addFunction("twice", [](double a) { return a * 3.0; });  // the compiled expression calls its copy
+    ev.parse("x");
+    ez::EvalContext ctx(compiled);
+    if (ctx.set("x", 0.5).eval().getResult() != 5.0) return false;
+    double result = 0.0;
+    return ctx.set("x", 0.0).tryEval(result) == ez::ErrorCode::DIVISION_BY_ZERO;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//// ENTRY POINT ///////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+#define IfTestExist(v) \
+    if (vTest == std::string(#v)) return v()
+
+bool Test_Expr_Jits_run_test(const std::string& vTest) {
+    IfTestExist(Test_Expr_Jit_Results);
+    else IfTestExist(Test_Expr_Jit_Errors);
+    else IfTestExist(Test_Expr_Jit_Functions);
+    else IfTestExist(Test_Expr_Jit_DeepStack);
+    else IfTestExist(Test_Expr_Jit_Context);
+    // default
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,257 @@
+﻿/*
+MIT License
+
+Copyright (c) 2024 Stephane Cuillerdier (aka aiekick)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <EzExpr/maths/Test_Expr_Maths.h>
+#include <EzExpr.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+//// MATHS /////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+typedef double (*StdUnary)(double);
+typedef double (*StdBinary)(double, double);
+
+static const size_t s_Count = 100000U;
+
+// distance in ulp between two doubles, the NaNs are equals
+static uint64_t ulpDistance(const double vA, const double vB) {
+    if (std::isnan(vA) || std::isnan(vB)) return (std::isnan(vA) && std::isnan(vB)) ? 0U : UINT64_MAX;
+    if (vA == vB) return 0U;
+    int64_t a, b;
+    std::memcpy(&a, &vA, sizeof(double));
+    std::memcpy(&b, &vB, sizeof(double));
+    if (a < 0) a = INT64_MIN - a;
+    if (b < 0) b = INT64_MIN - b;
+    return a > b ? static_cast<uint64_t>(a) - static_cast<uint64_t>(b) : static_cast<uint64_t>(b) - static_cast<uint64_t>(a);
+}
+
+// the vector kernels gives the same bits as the scalar reference, the ones not available are skipped
+static bool checkVectorKernels(const std::vector<double>& vRef, const std::vector<double>& vA, const std::vector<double>* vB, ez::simd::UnaryKernel ez::simd::Kernels::*vUnary, ez::simd::BinaryKernel ez::simd::Kernels::*vBinary) {
+    const ez::InstructionSet sets[] = {ez::InstructionSet::SSE2, ez::InstructionSet::AVX2};
+    for (const auto set : sets) {
+        const ez::simd::Kernels& kernels = ez::simd::getKernels(set);
+        std::vector<double> out(vA);
+        if (vUnary != nullptr) {
+            if (kernels.*vUnary == nullptr) continue;
+            (kernels.*vUnary)(out.data(), out.size());
+        } else {
+            if (kernels.*vBinary == nullptr) continue;
+            (kernels.*vBinary)(out.data(), vB->data(), out.size());
+        }
+        if (std::memcmp(out.data(), vRef.data(), out.size() * sizeof(double)) != 0) return false;
+    }
+    return true;
+}
+
+// random sweep of an unary function, checked against the standard library
+static bool checkUnary(ez::simd::UnaryKernel vScalar, ez::simd::UnaryKernel ez::simd::Kernels::*vKernel, StdUnary vStd, const double vMin, const double vMax, const uint64_t vMaxUlp) {
+    std::mt19937_64 rng(1234U);
+    std::uniform_real_distribution<double> dist(vMin, vMax);
+    std::vector<double> x(s_Count);
+    for (auto& v : x) v = dist(rng);
+    std::vector<double> ref(x);
+    vScalar(ref.data(), ref.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        if (ulpDistance(ref[i], vStd(x[i])) > vMaxUlp) return false;
+    }
+    return checkVectorKernels(ref, x, nullptr, vKernel, nullptr);
+}
+
+// random sweep of a binary function, checked against the standard library
+static bool checkBinary(ez::simd::BinaryKernel vScalar, ez::simd::BinaryKernel ez::simd::Kernels::*vKernel, StdBinary vStd, const std::vector<double>& vA, const std::vector<double>& vB, const uint64_t vMaxUlp) {
+    std::vector<double> ref(vA);
+    vScalar(ref.data(), vB.data(), ref.size());
+    for (size_t i = 0; i < vA.size(); ++i) {
+        if (ulpDistance(ref[i], vStd(vA[i], vB[i])) > vMaxUlp) return false;
+    }
+    return checkVectorKernels(ref, vA, &vB, nullptr, vKernel);
+}
+
+static double stdExp(double v) { return std::exp(v); }
+static double stdLog(double v) { return std::log(v); }
+static double stdLog2(double v) { return std::log2(v); }
+static double stdLog10(double v) { return std::log10(v); }
+static double stdSin(double v) { return std::sin(v); }
+static double stdCos(double v) { return std::cos(v); }
+static double stdTan(double v) { return std::tan(v); }
+static double stdAtan2(double a, double b) { return std::atan2(a, b); }
+static double stdPow(double a, double b) { return std::pow(a, b); }
+
+bool Test_Expr_Math_Exp() {
+    return checkUnary(ez::simd::scalar::exp, &ez::simd::Kernels::exp, stdExp, -750.0, 710.0, 1U) &&  //
+        checkUnary(ez::simd::scalar::exp, &ez::simd::Kernels::exp, stdExp, -1.0, 1.0, 1U);
+}
+
+bool Test_Expr_Math_Log() {
+    return checkUnary(ez::simd::scalar::log, &ez::simd::Kernels::log, stdLog, 1e-300, 1e300, 1U) &&  //
+        checkUnary(ez::simd::scalar::log, &ez::simd::Kernels::log, stdLog, 0.5, 2.0, 1U);
+}
+
+bool Test_Expr_Math_Log2() {
+    return checkUnary(ez::simd::scalar::log2, &ez::simd::Kernels::log2, stdLog2, 1e-300, 1e300, 1U) &&  //
+        checkUnary(ez::simd::scalar::log2, &ez::simd::Kernels::log2, stdLog2, 0.5, 2.0, 1U);
+}
+
+bool Test_Expr_Math_Log10() {
+    return checkUnary(ez::simd::scalar::log10, &ez::simd::Kernels::log10, stdLog10, 1e-300, 1e300, 2U) &&  //
+        checkUnary(ez::simd::scalar::log10, &ez::simd::Kernels::log10, stdLog10, 0.5, 2.0, 2U);
+}
+
+// the arguments above 1e5 are given to the standard library
+bool Test_Expr_Math_Sin() {
+    return checkUnary(ez::simd::scalar::sin, &ez::simd::Kernels::sin, stdSin, -10.0, 10.0, 1U) &&  //
+        checkUnary(ez::simd::scalar::sin, &ez::simd::Kernels::sin, stdSin, -2e5, 2e5, 1U);
+}
+
+bool Test_Expr_Math_Cos() {
+    return checkUnary(ez::simd::scalar::cos, &ez::simd::Kernels::cos, stdCos, -10.0, 10.0, 1U) &&  //
+        checkUnary(ez::simd::scalar::cos, &ez::simd::Kernels::cos, stdCos, -2e5, 2e5, 1U);
+}
+
+bool Test_Expr_Math_Tan() {
+    return checkUnary(ez::simd::scalar::tan, &ez::simd::Kernels::tan, stdTan, -10.0, 10.0, 2U) &&  //
+        checkUnary(ez::simd::scalar::tan, &ez::simd::Kernels::tan, stdTan, -2e5, 2e5, 2U);
+}
+
+bool Test_Expr_Math_Atan2() {
+    std::mt19937_64 rng(5678U);
+    std::uniform_real_distribution<double> dist(-10.0, 10.0);
+    std::uniform_int_distribution<int> scale(-5, 5);
+    std::vector<double> a(s_Count), b(s_Count);
+    for (size_t i = 0; i < s_Count; ++i) {
+        a[i] = dist(rng) * std::pow(10.0, scale(rng));
+        b[i] = dist(rng) * std::pow(10.0, scale(rng));
+    }
+    const double zeros[][2] = {{0.0, 0.0}, {0.0, -0.0}, {-0.0, 0.0}, {-0.0, -0.0}, {0.0, 3.0}, {0.0, -3.0}, {2.0, 0.0}, {-2.0, -0.0}};
+    for (size_t i = 0; i < 8U; ++i) {
+        a[i] = zeros[i][0];
+        b[i] = zeros[i][1];
+    }
+    return checkBinary(ez::simd::scalar::atan2, &ez::simd::Kernels::atan2, stdAtan2, a, b, 2U);
+}
+
+// the exponents are chosen so the results stays finite
+bool Test_Expr_Math_Pow() {
+    std::mt19937_64 rng(9012U);
+    std::uniform_real_distribution<double> logs(-700.0, 700.0);
+    std::vector<double> a(s_Count), b(s_Count);
+    for (size_t i = 0; i < s_Count; ++i) {
+        a[i]             = std::exp(logs(rng));
+        const double lim = 700.0 / std::max(std::abs(std::log(a[i])), 1.0);
+        b[i]             = std::uniform_real_distribution<double>(-lim, lim)(rng);
+    }
+    a[0] = 0.0;  // zero base
+    b[0] = 2.0;
+    a[1] = 1.0;  // huge exponent
+    b[1] = 1e300;
+    a[2] = 2.0;  // exact powers
+    b[2] = 10.0;
+    return checkBinary(ez::simd::scalar::pow, &ez::simd::Kernels::pow, stdPow, a, b, 2U);
+}
+
+// the special values gives the same results than the standard library
+bool Test_Expr_Math_SpecialValues() {
+    const double inf = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> x = {0.0, -0.0, -1.0, inf, -inf, nan, 1e-310, 800.0, -800.0, 1.0};
+    const StdUnary stds[] = {stdExp, stdLog, stdLog2, stdLog10, stdSin, stdCos, stdTan};
+    const ez::simd::UnaryKernel scalars[] = {ez::simd::scalar::exp, ez::simd::scalar::log, ez::simd::scalar::log2, ez::simd::scalar::log10, ez::simd::scalar::sin, ez::simd::scalar::cos, ez::simd::scalar::tan};
+    ez::simd::UnaryKernel ez::simd::Kernels::*const kernels[] = {
+        &ez::simd::Kernels::exp, &ez::simd::Kernels::log, &ez::simd::Kernels::log2, &ez::simd::Kernels::log10, &ez::simd::Kernels::sin, &ez::simd::Kernels::cos, &ez::simd::Kernels::tan};
+    for (size_t f = 0; f < 7U; ++f) {
+        std::vector<double> ref(x);
+        scalars[f](ref.data(), ref.size());
+        for (size_t i = 0; i < x.size(); ++i) {
+            if (ulpDistance(ref[i], stds[f](x[i])) > 1U) return false;
+            if (std::isinf(ref[i]) && std::signbit(ref[i]) != std::signbit(stds[f](x[i]))) return false;
+        }
+        if (!checkVectorKernels(ref, x, nullptr, kernels[f], nullptr)) return false;
+    }
+    std::vector<double> a, b;
+    for (const double va : x) {
+        for (const double vb : x) {
+            a.push_back(va);
+            b.push_back(vb);
+        }
+    }
+    const StdBinary binaryStds[] = {stdAtan2, stdPow};
+    const ez::simd::BinaryKernel binaryScalars[] = {ez::simd::scalar::atan2, ez::simd::scalar::pow};
+    ez::simd::BinaryKernel ez::simd::Kernels::*const binaryKernels[] = {&ez::simd::Kernels::atan2, &ez::simd::Kernels::pow};
+    for (size_t f = 0; f < 2U; ++f) {
+        std::vector<double> ref(a);
+        binaryScalars[f](ref.data(), b.data(), ref.size());
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (ulpDistance(ref[i], binaryStds[f](a[i], b[i])) > 2U) return false;
+        }
+        if (!checkVectorKernels(ref, a, &b, nullptr, binaryKernels[f])) return false;
+    }
+    return true;
+}
+
+// the scalar instruction set keeps the results of the standard library
+bool Test_Expr_Math_ScalarExact() {
+    const size_t count = 500U;
+    std::vector<double> x(count), out(count);
+    for (size_t row = 0; row < count; ++row) {
+        x[row] = static_cast<double>(row) * 0.37 + 0.01;
+    }
+    ez::Expr ev;
+    ev.parse("exp(x * 0.1) + ln(x) + log2(x) + log10(x) + sin(x) * cos(x) + tan(x) + atan2(x, 3) + x ^ 1.7");
+    ev.setInstructionSet(ez::InstructionSet::SCALAR);
+    ev.evalBatch(count, {{"x", x.data()}}, out.data());
+    for (size_t row = 0; row < count; ++row) {
+        const double expected = ev.set("x", x[row]).eval().getResult();
+        if (std::memcmp(&out[row], &expected, sizeof(double)) != 0) return false;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//// ENTRY POINT ///////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+#define IfTestExist(v) \
+    if (vTest == std::string(#v)) return v()
+
+bool Test_Expr_Maths_run_test(const std::string& vTest) {
+    IfTestExist(Test_Expr_Math_Exp);
+    else IfTestExist(Test_Expr_Math_Log);
+    else IfTestExist(Test_Expr_Math_Log2);
+    else IfTestExist(Test_Expr_Math_Log10);
+    else IfTestExist(Test_Expr_Math_Sin);
+    else IfTestExist(Test_Expr_Math_Cos);
+    else IfTestExist(Test_Expr_Math_Tan);
+    else IfTestExist(Test_Expr_Math_Atan2);
+    else IfTestExist(Test_Expr_Math_Pow);
+    else IfTestExist(Test_Expr_Math_SpecialValues);
+    else IfTestExist(Test_Expr_Math_ScalarExact);
+    // default
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,300 @@
+﻿/*
+MIT License
+
+Copyright (c) 2024 Stephane Cuillerdier (aka aiekick)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <EzExpr/optimizations/Test_Expr_Optimizations.h>
+#include <EzExpr.hpp>
+
+////////////////////////////////////////////////////////////////////////////
+//// CONSTANT FOLDING //////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+// a constant subtree is replaced by its value
+bool Test_Expr_Optimization_Folding_Operators() {
+    ez::Expr ev;
+    ev.parse("a + (5 * 2)");
+    if (ev.getProgram().code.size() != 3U) return false;  // a, 10, +
+    return ev.set("a", 1.0).eval().check(11.0);
+}
+
+// the calls of the builtins with constant arguments are folded
+bool Test_Expr_Optimization_Folding_Builtins() {
+    ez::Expr ev;
+    ev.parse("sqrt(pow(2, 1.5) + pi) * clamp(-3!, -1, 1)");
+    if (ev.getProgram().code.size() != 1U) return false;
+    return ev.eval().check(-std::sqrt(std::pow(2.0, 1.5) + M_PI));
+}
+
+// the constant folding can be disabled
+bool Test_Expr_Optimization_Folding_Disabled() {
+    ez::Expr ev;
+    ev.setConstantFolding(false).parse("a + (5 * 2)");
+    if (ev.getProgram().code.size() != 5U) return false;
+    if (!ev.set("a", 1.0).eval().check(11.0)) return false;
+    ev.setConstantFolding(true);
+    if (ev.getProgram().code.size() != 3U) return false;
+    return ev.eval().check(11.0);
+}
+
+// a constant subtree raising an error is kept, the error is reported at evaluation
+bool Test_Expr_Optimization_Folding_DeferredError() {
+    ez::Expr ev;
+    ev.parse("x + 1 / (2 - 2)").set("x", 1.0);
+    if (ev.getProgram().code.size() != 5U) return false;  // x, 1, 0, /, +
+    try {
+        ev.eval();
+        return false;  // Expected an exception
+    } catch (const ez::ExprException& e) { return e.getCode() == ez::ErrorCode::DIVISION_BY_ZERO; }
+}
+
+// a constant subtree evaluated to NaN is reported at evaluation
+bool Test_Expr_Optimization_Folding_DeferredNaN() {
+    ez::Expr ev;
+    ev.parse("sqrt(-1) + x").set("x", 1.0);
+    try {
+        ev.eval();
+        return false;  // Expected an exception
+    } catch (const ez::ExprException& e) { return e.getCode() == ez::ErrorCode::EVALUATION_NAN; }
+}
+
+// a function not declared as pure is called at each evaluation
+bool Test_Expr_Optimization_Folding_ImpureFunction() {
+    ez::Expr ev;
+    int count = 0;
+    ev.addFunction("counter", [&count](double a) { return a + (++count); });
+    ev.parse("counter(1)");
+    if (!ev.eval().check(2.0)) return false;
+    if (!ev.eval().check(3.0)) return false;
+    return count == 2;
+}
+
+// a function declared as pure is folded
+bool Test_Expr_Optimization_Folding_PureFunction() {
+    ez::Expr ev;
+    int count = 0;
+    ev.addFunction("twice", [&count](double a) { ++count; return a * 2.0; }, true);
+    ev.parse("twice(4) + x").set("x", 1.0);
+    if (ev.getProgram().code.size() != 3U) return false;
+    if (!ev.eval().check(9.0)) return false;
+    if (!ev.eval().check(9.0)) return false;
+    return count == 1;  // only called during parsing
+}
+
+// a folded function replaced after the parsing is folded again
+bool Test_Expr_Optimization_Folding_FunctionReplaced() {
+    ez::Expr ev;
+    ev.parse("sin(0) + x").set("x", 1.0);
+    if (!ev.eval().check(1.0)) return false;
+    ev.addFunction("sin", [](double) { return 5.0; }, true);
+    return ev.eval().check(6.0);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//// ALGEBRAIC SIMPLIFICATION //////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+// no simplification is done by default
+bool Test_Expr_Optimization_Simplification_Disabled() {
+    ez::Expr ev;
+    ev.parse("x * 1");
+    if (ev.getProgram().code.size() != 3U) return false;
+    return ev.set("x", 3.0).eval().check(3.0);
+}
+
+// the exact rewrites remove the neutral operations
+bool Test_Expr_Optimization_Simplification_Exact() {
+    ez::Expr ev;
+    ev.setSimplification(ez::SimplificationMode::EXACT).parse("-(-(1 * x / 1 - 0 * 1)) * (2 - 1)");
+    if (ev.getProgram().code.size() != 1U) return false;
+    if (!ev.set("x", -0.0).eval().check(0.0) || !std::signbit(ev.getResult())) return false;
+    return ev.set("x", 3.5).eval().check(3.5);
+}
+
+// the exact rewrites keep the operations changing the rounding or the sign of zero
+bool Test_Expr_Optimization_Simplification_ExactKept() {
+    ez::Expr ev;
+    ev.setSimplification(ez::SimplificationMode::EXACT).parse("(x + 0) + x ^ 2 + x ^ 0.5");
+    if (ev.getProgram().code.size() != 11U) return false;
+    return ev.set("x", 4.0).eval().check(4.0 + 16.0 + 2.0);
+}
+
+// the fast rewrites replace the powers by multiplications and square roots
+bool Test_Expr_Optimization_Simplification_Fast() {
+    ez::Expr ev;
+    ev.setSimplification(ez::SimplificationMode::FAST).parse("x + 0");
+    if (ev.getProgram().code.size() != 1U) return false;
+    ev.parse("x ^ 3 + pow(x, -2) + x ^ 0.5");
+    if (ev.getProgram().code.size() != 8U) return false;  // x, POWI, x, POWI, +, x, SQRT, +
+    const double x = 4.0;
+    return ev.set("x", x).eval().check(x * x * x + 1.0 / (x * x) + std::sqrt(x));
+}
+
+// a power of a negative base still raises an error once simplified
+bool Test_Expr_Optimization_Simplification_NegativeBase() {
+    ez::Expr ev;
+    ev.setSimplification(ez::SimplificationMode::FAST).parse("x ^ 2").set("x", -2.0);
+    try {
+        ev.eval();
+        return false;  // Expected an exception
+    } catch (const ez::ExprException& e) { return e.getCode() == ez::ErrorCode::EVALUATION_NAN; }
+}
+
+// a pow function defined by the user is not rewritten
+bool Test_Expr_Optimization_Simplification_UserPow() {
+    ez::Expr ev;
+    ev.addFunction("pow", [](double a, double b) { return a + b; }, true);
+    ev.setSimplification(ez::SimplificationMode::FAST).parse("pow(x, 2)").set("x", 3.0);
+    return ev.eval().check(5.0);
+}
+
+// changing the mode lowers the syntax tree again
+bool Test_Expr_Optimization_Simplification_ModeChanged() {
+    ez::Expr ev;
+    ev.parse("x * 1").set("x", 2.0);
+    ev.setSimplification(ez::SimplificationMode::EXACT);
+    if (ev.getProgram().code.size() != 1U) return false;
+    if (!ev.eval().check(2.0)) return false;
+    ev.setSimplification(ez::SimplificationMode::NONE);
+    if (ev.getProgram().code.size() != 3U) return false;
+    return ev.eval().check(2.0);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//// COMMON SUBEXPRESSIONS /////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+static size_t countOpCodes(const ez::Expr& vExpr, ez::OpCode vOp) {
+    size_t count = 0U;
+    for (const auto& ins : vExpr.getProgram().code) {
+        if (ins.op == vOp) ++count;
+    }
+    return count;
+}
+
+// an identical subexpression is evaluated once and reused
+bool Test_Expr_Optimization_CSE_Shared() {
+    ez::Expr ev;
+    ev.parse("1 / (a + 1) + 2 / (a + 1) + 3 / (a + 1)").set("a", 3.0);
+    if (countOpCodes(ev, ez::OpCode::ADD) != 3U) return false;  // a + 1 once, and the two sums
+    if (countOpCodes(ev, ez::OpCode::LOAD_TEMP) != 2U) return false;
+    return ev.eval().check(1.0 / 4.0 + 2.0 / 4.0 + 3.0 / 4.0);
+}
+
+// a pure function called with the same arguments is called once per evaluation
+bool Test_Expr_Optimization_CSE_PureFunction() {
+    size_t calls = 0U;
+    ez::Expr ev;
+    ev.addFunction("f", [&calls](double a) { ++calls; return a * 2.0; }, true);
+    ev.parse("f(x) * k + f(x) * k - f(x)").set("x", 2.0).set("k", 3.0);
+    if (!ev.eval().check(4.0 * 3.0 + 4.0 * 3.0 - 4.0)) return false;
+    return calls == 1U;
+}
+
+// each call of an impure function is evaluated
+bool Test_Expr_Optimization_CSE_ImpureFunction() {
+    size_t calls = 0U;
+    ez::Expr ev;
+    ev.addFunction("f", [&calls](double a) { ++calls; return a * 2.0; });
+    ev.parse("f(x) + f(x)").set("x", 2.0);
+    if (!ev.eval().check(8.0)) return false;
+    return calls == 2U;
+}
+
+// the common subexpressions elimination can be disabled
+bool Test_Expr_Optimization_CSE_Disabled() {
+    size_t calls = 0U;
+    ez::Expr ev;
+    ev.addFunction("f", [&calls](double a) { ++calls; return a * 2.0; }, true);
+    ev.setCommonSubexpressionElimination(false).parse("f(x) + f(x)").set("x", 2.0);
+    if (!ev.eval().check(8.0) || calls != 2U) return false;
+    ev.setCommonSubexpressionElimination(true);
+    calls = 0U;
+    if (!ev.eval().check(8.0)) return false;
+    return calls == 1U;
+}
+
+// a shared subexpression raising an error still reports it
+bool Test_Expr_Optimization_CSE_Error() {
+    ez::Expr ev;
+    ev.parse("1 / (x - 1) + 1 / (x - 1)").set("x", 1.0);
+    try {
+        ev.eval();
+        return false;  // Expected an exception
+    } catch (const ez::ExprException& e) { return e.getCode() == ez::ErrorCode::DIVISION_BY_ZERO; }
+}
+
+// the shared values are computed again at each evaluation
+bool Test_Expr_Optimization_CSE_Reevaluated() {
+    ez::Expr ev;
+    ev.parse("sin(x) * sin(x) + cos(x) * cos(x) + sin(x)");
+    for (double x = -2.0; x < 2.0; x += 0.5) {
+        const double expected = std::sin(x) * std::sin(x) + std::cos(x) * std::cos(x) + std::sin(x);
+        if (!ev.set("x", x).eval().check(expected)) return false;
+    }
+    return true;
+}
+
+// the simplifications rewrite the nodes in place, the root included, before the sharing
+bool Test_Expr_Optimization_CSE_Rewritten() {
+    ez::Expr ev;
+    ev.setSimplification(ez::SimplificationMode::FAST);
+    ev.parse("-(-((x * 1 + 0) ^ 2 + (x + 0) ^ 2))").set("x", 3.0);
+    if (!ev.eval().check(18.0)) return false;
+    ev.parse("(y / 1) * (y / 1) + y").set("y", 2.0);  // the tree of the previous parsing is replaced
+    if (!ev.eval().check(6.0)) return false;
+    return ev.parse("-(-y)").set("y", 2.0).eval().check(2.0);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//// ENTRY POINT ///////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+#define IfTestExist(v) \
+    if (vTest == std::string(#v)) return v()
+
+bool Test_Expr_Optimizations_run_test(const std::string& vTest) {
+    IfTestExist(Test_Expr_Optimization_Folding_Operators);
+    else IfTestExist(Test_Expr_Optimization_Folding_Builtins);
+    else IfTestExist(Test_Expr_Optimization_Folding_Disabled);
+    else IfTestExist(Test_Expr_Optimization_Folding_DeferredError);
+    else IfTestExist(Test_Expr_Optimization_Folding_DeferredNaN);
+    else IfTestExist(Test_Expr_Optimization_Folding_ImpureFunction);
+    else IfTestExist(Test_Expr_Optimization_Folding_PureFunction);
+    else IfTestExist(Test_Expr_Optimization_Folding_FunctionReplaced);
+    else IfTestExist(Test_Expr_Optimization_Simplification_Disabled);
+    else IfTestExist(Test_Expr_Optimization_Simplification_Exact);
+    else IfTestExist(Test_Expr_Optimization_Simplification_ExactKept);
+    else IfTestExist(Test_Expr_Optimization_Simplification_Fast);
+    else IfTestExist(Test_Expr_Optimization_Simplification_NegativeBase);
+    else IfTestExist(Test_Expr_Optimization_Simplification_UserPow);
+    else IfTestExist(Test_Expr_Optimization_Simplification_ModeChanged);
+    else IfTestExist(Test_Expr_Optimization_CSE_Shared);
+    else IfTestExist(Test_Expr_Optimization_CSE_PureFunction);
+    else IfTestExist(Test_Expr_Optimization_CSE_ImpureFunction);
+    else IfTestExist(Test_Expr_Optimization_CSE_Disabled);
+    else IfTestExist(Test_Expr_Optimization_CSE_Error);
+    else IfTestExist(Test_Expr_Optimization_CSE_Reevaluated);
+    else IfTestExist(Test_Expr_Optimization_CSE_Rewritten);
+    // default
+    return false;
+}
\ No newline at end of file
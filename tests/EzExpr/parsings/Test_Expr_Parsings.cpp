@@ -430,6 +430,54 @@ bool Test_Expr_Parsing_IncorrectUseOfMultipleOperators() {
     return true;
 }
 
+bool Test_Expr_Parsing_IncompleteNumber() {
+    const char* exprs[] = {".", "..5", "1e", "1e+", "2 * 1e-"};
+    for (const auto& expr : exprs) {
+        ez::Expr ev;
+        if (ev.tryParse(expr) != ez::ErrorCode::PARSE_ERROR) return false;  // the rest of the expression is not dropped
+    }
+    ez::Expr ev;
+    return ev.parse("1.e2 + .5 + 2E-1 + 3").eval().check(103.7);
+}
+
+// the literals are the nearest doubles, like the ones of the compiler
+bool Test_Expr_Parsing_ExactNumber() {
+    struct Literal {
+        const char* expr;
+        double value;
+    };
+    const Literal literals[] = {
+        {"0.1", 0.1},
+        {"123.456e-7", 123.456e-7},
+        {"2.2250738585072011e-308", 2.2250738585072011e-308},
+        {"4.9406564584124654e-324", 4.9406564584124654e-324},
+        {"1.7976931348623157e308", 1.7976931348623157e308},
+        {"9007199254740993", 9007199254740993.0},
+        {"0.30000000000000004", 0.30000000000000004},
+        {"12345678901234567890123", 12345678901234567890123.0},
+        {"000.00012345678901234567890123e5", 12.345678901234567890123},
+        {"1e-400", 0.0},
+    };
+    for (const auto& literal : literals) {
+        ez::Expr ev;
+        if (ev.parse(literal.expr).eval().getResult() != literal.value) return false;
+    }
+    return true;
+}
+
+// the postfix operator ! applies to a parenthesis and to a function call
+bool Test_Expr_Parsing_FactorialAfterParenthesis() {
+    ez::Expr ev;
+    if (!ev.parse("(x)!").set("x", 3.0).eval().check(6.0)) return false;
+    if (!ev.parse("(x + 1)! * 2").eval().check(48.0)) return false;
+    if (!ev.parse("-(x)! + fact(x)!").eval().check(714.0)) return false;
+    if (!ev.parse("(x!)!").eval().check(720.0)) return false;
+    try {
+        ev.parse("(x)! !");
+        return false;  // Expected an exception
+    } catch (const ez::ExprException& e) { return e.getCode() == ez::ErrorCode::PARSE_ERROR; }
+}
+
 ////////////////////////////////////////////////////////////////////////////
 //// ENTRY POINT ///////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////
@@ -479,6 +527,9 @@ bool Test_Expr_Parsings_run_test(const std::string& vTest) {
     else IfTestExist(Test_Expr_Parsing_IncorrectUseOfOpeningParenthesis);
     else IfTestExist(Test_Expr_Parsing_IncorrectVariableName);
     else IfTestExist(Test_Expr_Parsing_IncorrectUseOfMultipleOperators);
+    else IfTestExist(Test_Expr_Parsing_IncompleteNumber);
+    else IfTestExist(Test_Expr_Parsing_ExactNumber);
+    else IfTestExist(Test_Expr_Parsing_FactorialAfterParenthesis);
     // default
     return false;
 }
\ No newline at end of file
@@ -45,8 +45,11 @@ static bool Bench(const std::string& vEzExpr,
         assert(!vEzExpr.empty());
         ez::Expr ev;
         ev.parse(vEzExpr);
+        ez::Expr evJit;
+        evJit.setJitCompilation(true).parse(vEzExpr);
 
         double ezExprAccumulation = 0.0;
+        double ezJitAccumulation = 0.0;
         double cppExprAccumulation = 0.0;
         double tmp;
 
@@ -61,6 +64,17 @@ static bool Bench(const std::string& vEzExpr,
         auto end_ez = std::chrono::high_resolution_clock::now();
         vOutEzExprTotalTime = std::chrono::duration<double, std::milli>(end_ez - start_ez).count();
 
+        // EzExpr JIT Eval
+        auto start_jit = std::chrono::high_resolution_clock::now();
+        for (int j = 0; j < vIterations; ++j) {
+            for (int i = 0; i < vIterations; ++i) {
+                tmp = i;
+                ezJitAccumulation += vEzExprIteration(evJit, tmp);
+            }
+        }
+        auto end_jit = std::chrono::high_resolution_clock::now();
+        const double ezJitTotalTime = std::chrono::duration<double, std::milli>(end_jit - start_jit).count();
+
         // Cpp Eval
         auto start_cpp = std::chrono::high_resolution_clock::now();
         for (int j = 0; j < vIterations; ++j) {
@@ -73,13 +87,16 @@ static bool Bench(const std::string& vEzExpr,
         vOutCppTotalTime = std::chrono::duration<double, std::milli>(end_cpp - start_cpp).count();
 
         double slowdown_total_percentage = ((vOutEzExprTotalTime / vOutCppTotalTime) - 1.0) * 100.0;
+        double jit_slowdown_total_percentage = ((ezJitTotalTime / vOutCppTotalTime) - 1.0) * 100.0;
 
         if (outputStreamPtr != nullptr) {
             (*outputStreamPtr) <<                      //
                 "| " << vEzExpr <<                     //
                 " | " << std::floor(vOutEzExprTotalTime * 100.0) / 100.0 <<        //
+                " | " << std::floor(ezJitTotalTime * 100.0) / 100.0 <<        //
                 " | " << std::floor(vOutCppTotalTime * 100.0) / 100.0 <<     //
                 " | " << slowdown_total_percentage <<  //
+                "% | " << jit_slowdown_total_percentage <<  //
                 "% |\n";
         }
 
@@ -89,7 +106,8 @@ static bool Bench(const std::string& vEzExpr,
         }*/
 
         // Comparaison des résultats accumulés
-        if (std::abs(ezExprAccumulation - cppExprAccumulation) > std::numeric_limits<double>::epsilon()) {
+        if (std::abs(ezExprAccumulation - cppExprAccumulation) > std::numeric_limits<double>::epsilon() ||  //
+            std::abs(ezJitAccumulation - cppExprAccumulation) > std::numeric_limits<double>::epsilon()) {
             if (outputStreamPtr != nullptr) {  //
                 (*outputStreamPtr) << "| " <<  //
                     vEzExpr << " | Accumulation mismatch |" << std::endl;
@@ -325,8 +343,8 @@ bool Test_Expr_Perfo_All(double slowdownThreshold, int iterations) {
 
     if (resultsFile.is_open()) {
         // Imprimer l'en-tête du tableau
-        resultsFile << "| Expression | EzExpr Total Time (ms) | C++ Total Time (ms) | Slowdown (%) |\n";
-        resultsFile << "|------------|------------------|-----------------|----------------|--------------|---------------------|-------------------|\n";
+        resultsFile << "| Expression | EzExpr Total Time (ms) | EzExpr JIT Total Time (ms) | C++ Total Time (ms) | Slowdown (%) | JIT Slowdown (%) |\n";
+        resultsFile << "|------------|------------------|----------------------|-----------------|----------------|--------------------|\n";
 
         // Exécution des tests
         res &= Test_Expr_Perfo_x_squared(slowdownThreshold, iterations, &resultsFile);
@@ -0,0 +1,307 @@
+﻿/*
+MIT License
+
+Copyright (c) 2024 Stephane Cuillerdier (aka aiekick)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <EzExpr/variables/Test_Expr_Variables.h>
+#include <EzExpr.hpp>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////
+//// VARIABLES /////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+// set a variable with its handle
+bool Test_Expr_Variable_Handle_Set() {
+    ez::Expr ev;
+    ev.parse("x * 2 + y");
+    const auto x = ev.getVarHandle("x");
+    const auto y = ev.getVarHandle("y");
+    if (!ev.set(x, 3.0).set(y, 1.0).eval().check(7.0)) return false;
+    if (!ev.set(x, 5.0).eval().check(11.0)) return false;
+    return true;
+}
+
+// the slots are dense and given in order of appearance
+bool Test_Expr_Variable_Handle_Slots() {
+    ez::Expr ev;
+    ev.parse("b + a * b - c");
+    if (ev.getVarHandle("b").slot != 0U) return false;
+    if (ev.getVarHandle("a").slot != 1U) return false;
+    if (ev.getVarHandle("c").slot != 2U) return false;
+    return true;
+}
+
+// a handle can only be get for a variable found during parsing
+bool Test_Expr_Variable_Handle_NotFound() {
+    ez::Expr ev;
+    ev.parse("x + 1");
+    try {
+        ev.getVarHandle("y");
+        return false;  // Expected an exception
+    } catch (const ez::ExprException& e) { return e.getCode() == ez::ErrorCode::VARIABLE_NOT_FOUND; }
+}
+
+// set by name and set by handle are the same variable
+bool Test_Expr_Variable_Handle_SetByName() {
+    ez::Expr ev;
+    ev.parse("x + 1").set("x", 1.0);
+    if (!ev.eval().check(2.0)) return false;
+    if (!ev.set(ev.getVarHandle("x"), 4.0).eval().check(5.0)) return false;
+    if (!ev.set("x", 9.0, true).eval().check(5.0)) return false;  // already defined
+    if (ev.getDefinedVars().at("x") != 4.0) return false;
+    return true;
+}
+
+// a variable defined before the parsing is used by the parsed expression
+bool Test_Expr_Variable_DefinedBeforeParsing() {
+    ez::Expr ev;
+    ev.set("x", 2.0).set("y", 3.0);
+    return ev.parse("x * y").eval().check(6.0);
+}
+
+// the variables values are kept from a parsing to another
+bool Test_Expr_Variable_KeptAfterReparse() {
+    ez::Expr ev;
+    ev.parse("x + y");
+    ev.set(ev.getVarHandle("x"), 2.0).set(ev.getVarHandle("y"), 3.0);
+    if (!ev.parse("y - x").eval().check(1.0)) return false;
+    return true;
+}
+
+// the modifications done through the defined variables reference are used
+bool Test_Expr_Variable_DefinedVarsRef() {
+    ez::Expr ev;
+    ev.parse("x + 1").set("x", 1.0);
+    ev.getDefinedVarsRef()["x"] = 10.0;
+    if (!ev.eval().check(11.0)) return false;
+    ev.set("x", 20.0);
+    if (!ev.isDefinedVariableExist("x")) return false;
+    if (ev.getDefinedVars().at("x") != 20.0) return false;
+    return ev.eval().check(21.0);
+}
+
+// a variable not defined is reported at evaluation
+bool Test_Expr_Variable_NotDefined() {
+    ez::Expr ev;
+    ev.parse("x + y").set("x", 1.0);
+    try {
+        ev.eval();
+        return false;  // Expected an exception
+    } catch (const ez::ExprException& e) { return e.getCode() == ez::ErrorCode::VARIABLE_NOT_FOUND; }
+}
+
+// a variable bound to a memory owned by the caller is read at each evaluation
+bool Test_Expr_Variable_Bind_Pointer() {
+    ez::Expr ev;
+    double x = 2.0;
+    ev.parse("x * 3").bindVariable("x", &x);
+    if (!ev.eval().check(6.0)) return false;
+    x = 5.0;
+    if (!ev.eval().check(15.0)) return false;
+    return true;
+}
+
+// a variable bound before the parsing, the binding is kept by a new parsing
+bool Test_Expr_Variable_Bind_BeforeParsing() {
+    ez::Expr ev;
+    double x = 2.0;
+    ev.bindVariable("x", &x);
+    if (!ev.parse("x + 1").eval().check(3.0)) return false;
+    if (!ev.parse("x * x").eval().check(4.0)) return false;
+    return true;
+}
+
+struct Test_Expr_Variable_State {
+    double x = 0.0;
+    int count = 0;
+    double y = 0.0;
+};
+
+// variables bound to the fields of a struct
+bool Test_Expr_Variable_Bind_Offset() {
+    ez::Expr ev;
+    Test_Expr_Variable_State a, b;
+    a.x = 1.0;
+    a.y = 2.0;
+    b.x = 10.0;
+    b.y = 20.0;
+    ev.parse("x + y * 2");
+    ev.bindVariableOffset("x", offsetof(Test_Expr_Variable_State, x));
+    ev.bindVariableOffset("y", offsetof(Test_Expr_Variable_State, y));
+    if (!ev.setBindingBase(&a).eval().check(5.0)) return false;
+    if (!ev.setBindingBase(&b).eval().check(50.0)) return false;
+    a.y = 3.0;
+    if (!ev.setBindingBase(&a).eval().check(7.0)) return false;
+    return true;
+}
+
+// a variable bound with an offset is not defined without binding base
+bool Test_Expr_Variable_Bind_OffsetWithoutBase() {
+    ez::Expr ev;
+    ev.parse("x + 1").bindVariableOffset("x", 0U);
+    try {
+        ev.eval();
+        return false;  // Expected an exception
+    } catch (const ez::ExprException& e) { return e.getCode() == ez::ErrorCode::VARIABLE_NOT_FOUND; }
+}
+
+// a set variable is not bound anymore
+bool Test_Expr_Variable_Bind_SetDetach() {
+    ez::Expr ev;
+    double x = 2.0;
+    ev.parse("x + 1").bindVariable("x", &x);
+    ev.set(ev.getVarHandle("x"), 10.0);
+    x = 5.0;
+    if (!ev.eval().check(11.0)) return false;
+    if (!ev.parse("x * 2").eval().check(20.0)) return false;  // still detached after a new parsing
+    return true;
+}
+
+// an unbound variable get back its defined value
+bool Test_Expr_Variable_Bind_Unbind() {
+    ez::Expr ev;
+    double x = 2.0;
+    ev.set("x", 7.0).parse("x + 1").bindVariable("x", &x);
+    if (!ev.eval().check(3.0)) return false;
+    if (!ev.unbindVariable("x").eval().check(8.0)) return false;
+    return true;
+}
+
+// the names are found whatever the way their String was built, the hash being kept by the copies
+bool Test_Expr_Variable_Names() {
+    std::string expr = "0";
+    for (int i = 0; i < 200; ++i) {
+        expr += " + var" + std::to_string(i);
+    }
+    ez::Expr ev;
+    ev.parse(expr);
+    double expected = 0.0;
+    for (int i = 0; i < 200; ++i) {
+        const ez::String name = ez::String("var") + std::to_string(i).c_str();
+        ev.set(i % 2 == 0 ? name : ez::String(name.to_string()), static_cast<double>(i));
+        expected += static_cast<double>(i);
+    }
+    if (ez::String("var1") + "2" != ez::String("var12") || ez::String("var12").getHash() != (ez::String("var") + "12").getHash()) return false;
+    return ev.getParsedVars().size() == 200U && ev.eval().check(expected);
+}
+
+// the containers of the variables find their entries after growing and erasing, with short and long names
+bool Test_Expr_Variable_Containers() {
+    ez::VarContainer vars;
+    for (int i = 0; i < 1000; ++i) {
+        const std::string name = (i % 2 == 0 ? "v" : "a_long_variable_name_") + std::to_string(i);
+        if (!vars.emplace(name, static_cast<double>(i)).second) return false;
+    }
+    if (vars.emplace("v0", 5.0).second || vars.at("v0") != 0.0) return false;
+    for (int i = 0; i < 1000; i += 3) {
+        const std::string name = (i % 2 == 0 ? "v" : "a_long_variable_name_") + std::to_string(i);
+        if (vars.erase(name) != 1U || vars.erase(name) != 0U) return false;
+    }
+    for (int i = 0; i < 1000; ++i) {
+        const std::string name = (i % 2 == 0 ? "v" : "a_long_variable_name_") + std::to_string(i);
+        const auto it          = vars.find(name);
+        if ((i % 3 == 0) != (it == vars.end())) return false;
+        if (it != vars.end() && (it->first != name.c_str() || it->second != static_cast<double>(i))) return false;
+    }
+    vars["v0"] = 1.5;
+    if (vars.size() != 667U || vars.count("v0") != 1U || vars.at("v0") != 1.5) return false;
+    try {
+        vars.at("v3");
+        return false;  // Expected an exception
+    } catch (const std::out_of_range&) {}
+    vars.clear();
+    return vars.empty() && vars.find("v1") == vars.end();
+}
+
+// the containers have the members of std::unordered_map used by the user code
+bool Test_Expr_Variable_ContainersInterface() {
+    ez::VarContainer vars = {{"x", 1.0}, {"y", 2.0}, {"x", 3.0}};
+    if (vars.size() != 2U || vars.at("x") != 1.0) return false;
+    if (!vars.insert(ez::VarContainer::value_type("z", 3.0)).second || vars.insert(std::make_pair(ez::String("y"), 5.0)).second) return false;
+    std::unordered_map<std::string, double> others = {{"a", 4.0}, {"b", 5.0}};
+    vars.insert(others.begin(), others.end());
+    double sum = 0.0;
+    for (auto it = vars.cbegin(); it != vars.cend(); ++it) {
+        sum += it->second;
+    }
+    if (vars.size() != 5U || sum != 15.0) return false;
+    for (auto it = vars.begin(); it != vars.end();) {
+        if (it->second < 3.0) {
+            it = vars.erase(it);  // x and y
+        } else {
+            ++it;
+        }
+    }
+    if (vars.size() != 3U || vars.count("x") != 0U || vars.count("y") != 0U) return false;
+    const ez::VarContainer& constVars = vars;
+    auto last = vars.erase(constVars.find("b"));
+    return vars.size() == 2U && vars.count("b") == 0U && (last == vars.end() || vars.count(last->first) == 1U) && vars.at("a") == 4.0 && vars.at("z") == 3.0;
+}
+
+// the empty strings are equal and have the same hash, whatever the way they were built
+bool Test_Expr_Variable_EmptyNames() {
+    const ez::String empty;
+    ez::String moved("x");
+    const ez::String taken(std::move(moved));
+    const ez::String strings[] = {ez::String(""), ez::String(std::string()), ez::String("abc", 0U), moved};
+    for (const auto& str : strings) {
+        if (str != empty || !(empty == str) || str.getHash() != empty.getHash()) return false;
+        if (std::hash<ez::String>()(str) != std::hash<ez::String>()(empty)) return false;
+    }
+    return taken == "x";
+}
+
+////////////////////////////////////////////////////////////////////////////
+//// ENTRY POINT ///////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////
+
+#define IfTestExist(v) \
+    if (vTest == std::string(#v)) return v()
+
+bool Test_Expr_Variables_run_test(const std::string& vTest) {
+    IfTestExist(Test_Expr_Variable_Handle_Set);
+    else IfTestExist(Test_Expr_Variable_Handle_Slots);
+    else IfTestExist(Test_Expr_Variable_Handle_NotFound);
+    else IfTestExist(Test_Expr_Variable_Handle_SetByName);
+    else IfTestExist(Test_Expr_Variable_DefinedBeforeParsing);
+    else IfTestExist(Test_Expr_Variable_KeptAfterReparse);
+    else IfTestExist(Test_Expr_Variable_DefinedVarsRef);
+    else IfTestExist(Test_Expr_Variable_NotDefined);
+    else IfTestExist(Test_Expr_Variable_Bind_Pointer);
+    else IfTestExist(Test_Expr_Variable_Bind_BeforeParsing);
+    else IfTestExist(Test_Expr_Variable_Bind_Offset);
+    else IfTestExist(Test_Expr_Variable_Bind_OffsetWithoutBase);
+    else IfTestExist(Test_Expr_Variable_Bind_SetDetach);
+    else IfTestExist(Test_Expr_Variable_Bind_Unbind);
+    else IfTestExist(Test_Expr_Variable_Names);
+    else IfTestExist(Test_Expr_Variable_Containers);
+    else IfTestExist(Test_Expr_Variable_ContainersInterface);
+    else IfTestExist(Test_Expr_Variable_EmptyNames);
+    // default
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+/*
+MIT License
+
+Copyright (c) 2024 Stephane Cuillerdier (aka aiekick)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Generate a C++ header from a file of expressions, each expression becoming a standalone function
+// usage : EzExprToCpp <expressions file> <header file>
+// each line of the expressions file is "name = expression", the empty lines and the lines starting by # are ignored
+// only the builtins can be called, the arguments of a function are its variables in their order of appearance
+
+#include <EzExpr.hpp>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Remove the spaces at the start and at the end of a string
+static std::string Trim(const std::string& vStr) {
+    const auto start = vStr.find_first_not_of(" \t\r\n");
+    if (start == std::string::npos) {
+        return {};
+    }
+    const auto end = vStr.find_last_not_of(" \t\r\n");
+    return vStr.substr(start, end - start + 1);
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "usage : EzExprToCpp <expressions file> <header file>" << std::endl;
+        return 1;
+    }
+    std::ifstream input(argv[1]);
+    if (!input.is_open()) {
+        std::cerr << "Failed to open " << argv[1] << std::endl;
+        return 1;
+    }
+    std::stringstream header;
+    header << "// Generated by EzExprToCpp from " << argv[1] << ", don't edit\n";
+    header << "#pragma once\n\n";
+    header << "#include <cmath>\n";
+    header << "#include <limits>\n";
+    std::string line;
+    size_t lineNumber = 0U;
+    while (std::getline(input, line)) {
+        ++lineNumber;
+        line = Trim(line);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        const auto equal = line.find('=');
+        const std::string name = Trim(line.substr(0, equal));
+        if (equal == std::string::npos || name.empty()) {
+            std::cerr << argv[1] << ":" << lineNumber << ": expected \"name = expression\"" << std::endl;
+            return 1;
+        }
+        ez::Expr ev;
+        if (ev.tryParse(Trim(line.substr(equal + 1))) != ez::ErrorCode::NONE) {
+            std::cerr << argv[1] << ":" << lineNumber << ": " << ev.getError().message.c_str() << std::endl;
+            return 1;
+        }
+        header << "\n" << ev.toCppSource(name).c_str();
+    }
+    std::ofstream output(argv[2]);
+    if (!output.is_open()) {
+        std::cerr << "Failed to open " << argv[2] << std::endl;
+        return 1;
+    }
+    output << header.str();
+    return 0;
+}